@@ -0,0 +1,628 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "../concurrent_graph.hpp"
+#include "../frozen_graph.hpp"
+#include "../graph.hpp"
+#include "../graph_generator.hpp"
+#include "../graph_json_printing.hpp"
+#include "../graph_printing.hpp"
+#include "../graph_view.hpp"
+#include "../huge_page_memory_resource.hpp"
+
+using ConcurrentGraph = uni_course_cpp::ConcurrentGraph;
+using FrozenGraph = uni_course_cpp::FrozenGraph;
+using Graph = uni_course_cpp::Graph;
+using GraphGenerator = uni_course_cpp::GraphGenerator;
+using GraphView = uni_course_cpp::GraphView;
+using HugePageMemoryResource = uni_course_cpp::HugePageMemoryResource;
+
+namespace {
+double measure_milliseconds(const std::function<void()>& function) {
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  const auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+void print_result(const std::string& name, double milliseconds) {
+  std::cout << name << ": " << milliseconds << " ms" << std::endl;
+}
+
+// Unlike assert(), also checks optimized builds, which benchmarks are.
+void check(bool condition, const std::string& message) {
+  if (!condition) {
+    throw std::logic_error("Check failed: " + message);
+  }
+}
+
+using EdgeRecord =
+    std::tuple<Graph::VertexId, Graph::VertexId, Graph::Edge::Color>;
+
+std::vector<EdgeRecord> get_edge_records(const Graph& graph) {
+  auto edge_records = std::vector<EdgeRecord>();
+  edge_records.reserve(graph.get_edges().size());
+  for (const auto& edge : graph.get_edges()) {
+    edge_records.emplace_back(edge.from_vertex_id(), edge.to_vertex_id(),
+                              edge.color());
+  }
+  return edge_records;
+}
+
+// Checks that the graphs have the same vertex depths and list the same
+// edges in the same order.
+void check_same_graphs(const Graph& graph,
+                       const Graph& expected_graph,
+                       const std::string& name) {
+  const auto vertices_count = expected_graph.get_vertices().size();
+  check(graph.get_vertices().size() == vertices_count,
+        name + ": vertices count");
+  for (size_t vertex_id = 0; vertex_id < vertices_count; vertex_id++) {
+    check(graph.get_vertex_depth(vertex_id) ==
+              expected_graph.get_vertex_depth(vertex_id),
+          name + ": depth of vertex " + std::to_string(vertex_id));
+  }
+  check(get_edge_records(graph) == get_edge_records(expected_graph),
+        name + ": edges");
+}
+
+// Grows a random tree, every vertex attached to an earlier one and every
+// tenth vertex given a self loop. Vertex ids do not follow the depths.
+Graph make_random_tree(int vertices_count, std::mt19937& generator) {
+  auto graph = Graph();
+  graph.add_vertex();
+  for (int i = 1; i < vertices_count; i++) {
+    const auto parent_vertex_id =
+        std::uniform_int_distribution<Graph::VertexId>(0, i - 1)(generator);
+    const auto vertex_id = graph.add_vertex();
+    graph.add_edge(parent_vertex_id, vertex_id);
+    if (i % 10 == 0) {
+      graph.add_edge(vertex_id, vertex_id);
+    }
+  }
+  return graph;
+}
+
+// Adds a whole level of vertices before attaching them, so every attachment
+// moves a vertex out of a depth bucket holding the rest of the level.
+void benchmark_wide_level(int level_width, bool use_arena) {
+  const auto milliseconds = measure_milliseconds([level_width, use_arena]() {
+    auto graph =
+        use_arena
+            ? Graph(std::make_shared<std::pmr::monotonic_buffer_resource>())
+            : Graph();
+    const auto root_id = graph.add_vertex();
+    auto vertex_ids = std::vector<Graph::VertexId>();
+    vertex_ids.reserve(level_width);
+    for (int i = 0; i < level_width; i++) {
+      vertex_ids.push_back(graph.add_vertex());
+    }
+    for (const auto vertex_id : vertex_ids) {
+      graph.add_edge(root_id, vertex_id);
+    }
+  });
+
+  print_result("wide level, width " + std::to_string(level_width) +
+                   (use_arena ? ", arena" : ""),
+               milliseconds);
+}
+
+// Queries a hub vertex against every vertex of its children level, the way
+// yellow edge generation looks for unconnected vertices, once per child.
+void benchmark_vertices_connected(int level_width) {
+  auto graph = Graph();
+  const auto root_id = graph.add_vertex();
+  auto vertex_ids = std::vector<Graph::VertexId>();
+  vertex_ids.reserve(level_width);
+  for (int i = 0; i < level_width; i++) {
+    vertex_ids.push_back(graph.add_vertex());
+    graph.add_edge(root_id, vertex_ids.back());
+  }
+
+  int connected_count = 0;
+  const auto milliseconds = measure_milliseconds(
+      [&graph, root_id, &vertex_ids, &connected_count, level_width]() {
+        for (int attempt = 0; attempt < level_width; attempt++) {
+          for (const auto vertex_id : vertex_ids) {
+            connected_count += graph.is_vertices_connected(root_id, vertex_id);
+          }
+        }
+      });
+
+  print_result("vertices connected, width " + std::to_string(level_width) +
+                   " (" + std::to_string(connected_count) + " connected)",
+               milliseconds);
+}
+
+// Grows a tree from several threads at once, every thread attaching each
+// new vertex to the one it added before, once into a Graph behind a single
+// mutex and once into a ConcurrentGraph.
+void benchmark_concurrent_insertion(int threads_count, int vertices_count) {
+  const auto run_threads = [threads_count](const std::function<void()>& job) {
+    auto threads = std::vector<std::thread>();
+    for (int i = 0; i < threads_count; i++) {
+      threads.emplace_back(job);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  };
+
+  const auto mutex_milliseconds =
+      measure_milliseconds([threads_count, vertices_count, &run_threads]() {
+        auto graph = Graph();
+        std::mutex graph_mutex;
+        const auto root_id = graph.add_vertex();
+        run_threads([&graph, &graph_mutex, root_id, threads_count,
+                     vertices_count]() {
+          auto parent_vertex_id = root_id;
+          for (int i = 0; i < vertices_count / threads_count; i++) {
+            const std::lock_guard lock(graph_mutex);
+            const auto vertex_id = graph.add_vertex();
+            graph.add_edge(parent_vertex_id, vertex_id);
+            parent_vertex_id = vertex_id;
+          }
+        });
+      });
+
+  const auto concurrent_milliseconds =
+      measure_milliseconds([threads_count, vertices_count, &run_threads]() {
+        auto graph = ConcurrentGraph();
+        const auto root_id = graph.add_vertex();
+        run_threads([&graph, root_id, threads_count, vertices_count]() {
+          auto parent_vertex_id = root_id;
+          for (int i = 0; i < vertices_count / threads_count; i++) {
+            parent_vertex_id = graph.add_vertex(parent_vertex_id);
+          }
+        });
+      });
+
+  const auto name = "concurrent insertion, " + std::to_string(threads_count) +
+                    " threads, ";
+  print_result(name + "graph mutex", mutex_milliseconds);
+  print_result(name + "concurrent graph", concurrent_milliseconds);
+}
+
+// Forwards to the default resource and counts the bytes currently held.
+class CountingMemoryResource : public std::pmr::memory_resource {
+ public:
+  size_t allocated_bytes() const { return allocated_bytes_; }
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    allocated_bytes_ += bytes;
+    return std::pmr::get_default_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+    allocated_bytes_ -= bytes;
+    std::pmr::get_default_resource()->deallocate(pointer, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const
+      noexcept override {
+    return this == &other;
+  }
+
+  size_t allocated_bytes_ = 0;
+};
+
+// Grows a three level tree and links the root to every vertex of the last
+// level, reporting insert time and the memory held by the finished graph.
+void benchmark_indices(int level_width, const Graph::Indices& indices) {
+  auto memory_resource = CountingMemoryResource();
+  auto graph = Graph(&memory_resource, indices);
+  const auto milliseconds = measure_milliseconds([&graph, level_width]() {
+    const auto root_id = graph.add_vertex();
+    for (int i = 0; i < level_width; i++) {
+      const auto child_id = graph.add_vertex();
+      graph.add_edge(root_id, child_id);
+      graph.add_edge(child_id, graph.add_vertex());
+    }
+    for (int i = 0; i < level_width; i++) {
+      graph.add_edge(root_id, 2 * i + 2);
+    }
+  });
+
+  print_result("indices, width " + std::to_string(level_width) +
+                   (indices.neighbor_sets ? ", neighbor sets" : "") +
+                   (indices.depth_buckets ? ", depth buckets" : "") + ", " +
+                   std::to_string(memory_resource.allocated_bytes() / 1024) +
+                   " KiB",
+               milliseconds);
+}
+
+// Rebuilds a generated graph from its edge list, once edge by edge through
+// Graph and once through the bulk FrozenGraph constructor.
+void benchmark_bulk_loading(Graph::Depth depth, int new_vertices_count) {
+  const auto graph =
+      GraphGenerator(GraphGenerator::Params(depth, new_vertices_count))
+          .generate();
+  const auto vertices_count = graph.get_vertices().size();
+  auto edges = std::vector<FrozenGraph::EdgeRecord>();
+  edges.reserve(graph.get_edges().size());
+  for (const auto& edge : graph.get_edges()) {
+    edges.push_back({edge.from_vertex_id(), edge.to_vertex_id(), edge.color()});
+  }
+
+  const auto insertion_milliseconds =
+      measure_milliseconds([vertices_count, &edges]() {
+        auto rebuilt_graph = Graph();
+        for (size_t i = 0; i < vertices_count; i++) {
+          rebuilt_graph.add_vertex();
+        }
+        for (const auto& edge : edges) {
+          rebuilt_graph.add_edge(edge.from_vertex_id, edge.to_vertex_id);
+        }
+        const auto frozen_graph = rebuilt_graph.freeze();
+      });
+  const auto bulk_milliseconds =
+      measure_milliseconds([vertices_count, &edges]() {
+        const auto frozen_graph = FrozenGraph(vertices_count, edges);
+      });
+
+  const auto name = "loading " + std::to_string(edges.size()) + " edges, ";
+  print_result(name + "edge by edge", insertion_milliseconds);
+  print_result(name + "bulk", bulk_milliseconds);
+}
+
+// Grows a random tree, every vertex attached to an earlier one, then runs
+// random is_vertices_connected() queries and the JSON printer, which reads
+// edges_ in adjacency order, jumping all over the edge columns.
+void benchmark_huge_pages(int vertices_count, bool use_huge_pages) {
+  auto* memory_resource =
+      use_huge_pages ? uni_course_cpp::get_huge_page_memory_resource()
+                     : std::pmr::get_default_resource();
+  auto graph = Graph(memory_resource);
+  auto capacity = Graph::Capacity();
+  capacity.vertices_count = vertices_count;
+  graph.reserve(capacity);
+
+  auto generator = std::mt19937(vertices_count);
+  graph.add_vertex();
+  for (int i = 1; i < vertices_count; i++) {
+    const auto parent_vertex_id =
+        std::uniform_int_distribution<Graph::VertexId>(0, i - 1)(generator);
+    graph.add_edge(parent_vertex_id, graph.add_vertex());
+  }
+
+  int connected_count = 0;
+  const auto query_milliseconds =
+      measure_milliseconds([&graph, &generator, &connected_count]() {
+        const auto vertices_count = graph.get_vertices().size();
+        auto distribution = std::uniform_int_distribution<Graph::VertexId>(
+            0, vertices_count - 1);
+        for (size_t query = 0; query < vertices_count; query++) {
+          connected_count += graph.is_vertices_connected(
+              distribution(generator), distribution(generator));
+        }
+      });
+  size_t json_length = 0;
+  const auto printing_milliseconds =
+      measure_milliseconds([&graph, &json_length]() {
+        json_length = uni_course_cpp::printing::json::print_graph(graph).size();
+      });
+
+  const auto name =
+      std::to_string(vertices_count) + " vertices, " +
+      (use_huge_pages
+           ? uni_course_cpp::printing::print_memory_mode(
+                 uni_course_cpp::get_huge_page_memory_resource()->get_mode())
+           : "default resource");
+  print_result("vertices connected, " + name + " (" +
+                   std::to_string(connected_count) + " connected)",
+               query_milliseconds);
+  print_result("json printing, " + name + " (" + std::to_string(json_length) +
+                   " characters)",
+               printing_milliseconds);
+}
+
+// Prunes a random tree with self loops down to its upper levels, once with
+// tombstones and compact() and once by rebuilding the kept part of the
+// graph edge by edge.
+void benchmark_pruning(int vertices_count) {
+  auto generator = std::mt19937(vertices_count);
+  const auto graph = make_random_tree(vertices_count, generator);
+  const auto max_depth = graph.get_depth() / 2;
+
+  auto pruned_graph = graph.copy_to_new_arena();
+  const auto compaction_milliseconds =
+      measure_milliseconds([&pruned_graph, max_depth]() {
+        const auto& vertices = pruned_graph.get_vertices();
+        for (const auto& vertex : vertices) {
+          if (pruned_graph.get_vertex_depth(vertex.id()) > max_depth) {
+            pruned_graph.remove_vertex(vertex.id());
+          }
+        }
+        pruned_graph.compact();
+      });
+
+  auto rebuilt_graph = Graph();
+  const auto rebuilding_milliseconds = measure_milliseconds([&graph,
+                                                             max_depth,
+                                                             &rebuilt_graph]() {
+    const auto vertices_count = graph.get_vertices().size();
+    auto new_vertex_ids = std::vector<Graph::VertexId>(vertices_count);
+    for (size_t vertex_id = 0; vertex_id < vertices_count; vertex_id++) {
+      if (graph.get_vertex_depth(vertex_id) <= max_depth) {
+        new_vertex_ids[vertex_id] = rebuilt_graph.add_vertex();
+      }
+    }
+    for (const auto& edge : graph.get_edges()) {
+      if (graph.get_vertex_depth(edge.to_vertex_id()) <= max_depth) {
+        rebuilt_graph.add_edge(new_vertex_ids[edge.from_vertex_id()],
+                               new_vertex_ids[edge.to_vertex_id()]);
+      }
+    }
+  });
+
+  // Both keep the remaining vertices and edges in their order.
+  check(!pruned_graph.has_removed_entries(), "compact: removed entries");
+  check(pruned_graph.get_depth() == max_depth, "compact: depth");
+  check_same_graphs(pruned_graph, rebuilt_graph, "compact");
+
+  const auto name = "pruning " + std::to_string(vertices_count) +
+                    " vertices to " +
+                    std::to_string(pruned_graph.get_vertices().size()) + ", ";
+  print_result(name + "compact", compaction_milliseconds);
+  print_result(name + "rebuild", rebuilding_milliseconds);
+}
+
+// Unites many random trees with self loops into one forest, once through
+// Graph::merge() and once by adding their vertices and edges one by one.
+void benchmark_merging(int graphs_count, int vertices_count) {
+  auto graphs = std::vector<Graph>();
+  graphs.reserve(graphs_count);
+  auto generator = std::mt19937(graphs_count);
+  for (int i = 0; i < graphs_count; i++) {
+    graphs.push_back(make_random_tree(vertices_count, generator));
+  }
+
+  auto merged_graph = std::optional<Graph>();
+  const auto merging_milliseconds =
+      measure_milliseconds([&graphs, &merged_graph]() {
+        merged_graph.emplace(Graph::merge(graphs));
+      });
+
+  auto added_graph = Graph();
+  const auto adding_milliseconds = measure_milliseconds([&graphs,
+                                                         &added_graph]() {
+    for (const auto& graph : graphs) {
+      const Graph::VertexId vertex_offset = added_graph.get_vertices().size();
+      for (size_t i = 0; i < graph.get_vertices().size(); i++) {
+        added_graph.add_vertex();
+      }
+      for (const auto& edge : graph.get_edges()) {
+        added_graph.add_edge(edge.from_vertex_id() + vertex_offset,
+                             edge.to_vertex_id() + vertex_offset);
+      }
+    }
+  });
+
+  // Both shift the vertices of every graph past those before it and list
+  // grey edges by target vertex, then the other edges graph by graph.
+  check_same_graphs(*merged_graph, added_graph, "merge");
+
+  const auto name = "merging " + std::to_string(graphs_count) + " graphs, " +
+                    std::to_string(merged_graph->get_edges().size()) +
+                    " edges, ";
+  print_result(name + "merge", merging_milliseconds);
+  print_result(name + "edge by edge", adding_milliseconds);
+}
+
+// Renumbers a random tree, whose vertex ids do not follow the depths, so
+// that every depth gets consecutive ids.
+void benchmark_relabeling(int vertices_count) {
+  auto generator = std::mt19937(vertices_count);
+  auto graph = make_random_tree(vertices_count, generator);
+  const auto depth_order = graph.get_depth_order();
+  auto expected_edge_records = get_edge_records(graph);
+
+  const auto milliseconds = measure_milliseconds(
+      [&graph]() { graph.relabel_vertices_by_depth(); });
+
+  check(graph.get_vertices().size() == depth_order.size(),
+        "relabel_vertices_by_depth: vertices count");
+  for (size_t vertex_id = 1; vertex_id < depth_order.size(); vertex_id++) {
+    check(graph.get_vertex_depth(vertex_id - 1) <=
+              graph.get_vertex_depth(vertex_id),
+          "relabel_vertices_by_depth: depth of vertex " +
+              std::to_string(vertex_id));
+  }
+  // The edges are the same up to the new vertex ids.
+  auto new_vertex_ids = std::vector<Graph::VertexId>(depth_order.size());
+  for (size_t i = 0; i < depth_order.size(); i++) {
+    new_vertex_ids[depth_order[i]] = i;
+  }
+  for (auto& [from_vertex_id, to_vertex_id, color] : expected_edge_records) {
+    from_vertex_id = new_vertex_ids[from_vertex_id];
+    to_vertex_id = new_vertex_ids[to_vertex_id];
+  }
+  auto edge_records = get_edge_records(graph);
+  std::sort(expected_edge_records.begin(), expected_edge_records.end());
+  std::sort(edge_records.begin(), edge_records.end());
+  check(edge_records == expected_edge_records,
+        "relabel_vertices_by_depth: edges");
+
+  print_result("relabeling " + std::to_string(vertices_count) +
+                   " vertices by depth",
+               milliseconds);
+}
+
+// Collects the edges between the shallowest depths of a generated graph,
+// once through a GraphView and once by filtering the whole edge table.
+void benchmark_depth_view(Graph::Depth depth, int new_vertices_count) {
+  const auto graph =
+      GraphGenerator(GraphGenerator::Params(depth, new_vertices_count))
+          .generate();
+  const auto max_depth = depth / 2;
+
+  size_t view_edges_count = 0;
+  const auto view_milliseconds =
+      measure_milliseconds([&graph, max_depth, &view_edges_count]() {
+        const auto graph_view = GraphView(graph, 0, max_depth);
+        for ([[maybe_unused]] const auto& edge : graph_view.get_edges()) {
+          view_edges_count++;
+        }
+      });
+
+  size_t scanned_edges_count = 0;
+  const auto scan_milliseconds =
+      measure_milliseconds([&graph, max_depth, &scanned_edges_count]() {
+        for (const auto& edge : graph.get_edges()) {
+          if (graph.get_vertex_depth(edge.to_vertex_id()) <= max_depth) {
+            scanned_edges_count++;
+          }
+        }
+      });
+
+  const auto name = "depths [0, " + std::to_string(max_depth) + "], " +
+                    std::to_string(view_edges_count) + " of " +
+                    std::to_string(graph.get_edges().size()) + " edges, ";
+  print_result(name + "view", view_milliseconds);
+  print_result(name + "full scan", scan_milliseconds);
+}
+
+void benchmark_generation(Graph::Depth depth, int new_vertices_count) {
+  const auto milliseconds = measure_milliseconds([depth, new_vertices_count]() {
+    const auto graph =
+        GraphGenerator(GraphGenerator::Params(depth, new_vertices_count))
+            .generate();
+  });
+
+  print_result("generation, depth " + std::to_string(depth) +
+                   ", new vertices count " + std::to_string(new_vertices_count),
+               milliseconds);
+}
+
+void run_wide_level() {
+  for (const auto use_arena : {false, true}) {
+    for (const auto level_width : {10000, 20000, 40000, 80000}) {
+      benchmark_wide_level(level_width, use_arena);
+    }
+  }
+}
+
+void run_vertices_connected() {
+  for (const auto level_width : {500, 1000, 2000}) {
+    benchmark_vertices_connected(level_width);
+  }
+}
+
+void run_indices() {
+  for (const auto neighbor_sets : {true, false}) {
+    for (const auto depth_buckets : {true, false}) {
+      auto indices = Graph::Indices();
+      indices.neighbor_sets = neighbor_sets;
+      indices.depth_buckets = depth_buckets;
+      benchmark_indices(200000, indices);
+    }
+  }
+}
+
+void run_bulk_loading() {
+  benchmark_bulk_loading(4, 50);
+}
+
+void run_concurrent_insertion() {
+  for (const auto threads_count : {1, 2, 4, 8}) {
+    benchmark_concurrent_insertion(threads_count, 400000);
+  }
+}
+
+void run_huge_pages() {
+  for (const auto use_huge_pages : {false, true}) {
+    benchmark_huge_pages(2000000, use_huge_pages);
+  }
+}
+
+void run_pruning() {
+  benchmark_pruning(1000000);
+}
+
+void run_merging() {
+  benchmark_merging(1000, 1000);
+}
+
+void run_relabeling() {
+  benchmark_relabeling(1000000);
+}
+
+void run_depth_view() {
+  benchmark_depth_view(4, 50);
+}
+
+void run_generation() {
+  for (const auto new_vertices_count : {50, 75}) {
+    benchmark_generation(3, new_vertices_count);
+  }
+}
+
+struct Benchmark {
+  const char* name;
+  void (*run)();
+};
+
+constexpr std::array<Benchmark, 11> kBenchmarks = {{
+    {"wide_level", run_wide_level},
+    {"vertices_connected", run_vertices_connected},
+    {"indices", run_indices},
+    {"bulk_loading", run_bulk_loading},
+    {"concurrent_insertion", run_concurrent_insertion},
+    {"huge_pages", run_huge_pages},
+    {"pruning", run_pruning},
+    {"merging", run_merging},
+    {"relabeling", run_relabeling},
+    {"depth_view", run_depth_view},
+    {"generation", run_generation},
+}};
+}  // namespace
+
+// Usage: run_benchmark [benchmark names], all of them by default.
+int main(int argc, char** argv) {
+  auto benchmarks = std::vector<Benchmark>();
+  for (int i = 1; i < argc; i++) {
+    const auto benchmark =
+        std::find_if(kBenchmarks.begin(), kBenchmarks.end(),
+                     [argument = argv[i]](const Benchmark& benchmark) {
+                       return std::strcmp(benchmark.name, argument) == 0;
+                     });
+    if (benchmark == kBenchmarks.end()) {
+      std::cerr << "Unknown benchmark " << argv[i] << ", expected one of:";
+      for (const auto& known_benchmark : kBenchmarks) {
+        std::cerr << " " << known_benchmark.name;
+      }
+      std::cerr << std::endl;
+      return 1;
+    }
+    benchmarks.push_back(*benchmark);
+  }
+  if (benchmarks.empty()) {
+    benchmarks.assign(kBenchmarks.begin(), kBenchmarks.end());
+  }
+
+  try {
+    for (const auto& benchmark : benchmarks) {
+      benchmark.run();
+    }
+  } catch (const std::logic_error& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
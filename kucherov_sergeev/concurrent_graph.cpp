@@ -0,0 +1,105 @@
+#include <cassert>
+#include <stdexcept>
+
+#include "concurrent_graph.hpp"
+
+namespace uni_course_cpp {
+ConcurrentGraph::VertexId ConcurrentGraph::add_vertex() {
+  return create_vertex(Graph::EdgeTable::kNoParentVertexId,
+                       kGraphDefaultDepth);
+}
+
+ConcurrentGraph::VertexId ConcurrentGraph::add_vertex(
+    VertexId parent_vertex_id) {
+  auto& parent_vertex = vertices_[parent_vertex_id];
+  const auto vertex_id =
+      create_vertex(parent_vertex_id, parent_vertex.depth + 1);
+
+  const std::lock_guard lock(
+      vertex_mutexes_[parent_vertex_id % kStripesCount]);
+  parent_vertex.child_vertex_ids.push_back(vertex_id);
+
+  return vertex_id;
+}
+
+size_t ConcurrentGraph::get_vertices_count() const {
+  return vertices_count_.load();
+}
+
+ConcurrentGraph::Depth ConcurrentGraph::get_depth() const {
+  return depth_.load();
+}
+
+ConcurrentGraph::Depth ConcurrentGraph::get_vertex_depth(
+    VertexId vertex_id) const {
+  return vertices_[vertex_id].depth;
+}
+
+std::vector<ConcurrentGraph::VertexId> ConcurrentGraph::get_depth_vertex_ids(
+    Depth depth) const {
+  if (depth < kGraphDefaultDepth || depth > get_depth()) {
+    return {};
+  }
+
+  const auto& depth_bucket = depth_buckets_[depth];
+  const std::lock_guard lock(depth_bucket.mutex);
+  return depth_bucket.vertex_ids;
+}
+
+void ConcurrentGraph::copy_to(Graph& graph) const {
+  assert(graph.get_vertices().empty() && "Graph has to be empty");
+
+  const auto vertices_count = get_vertices_count();
+  auto depth_order = std::vector<VertexId>();
+  depth_order.reserve(vertices_count);
+  for (VertexId vertex_id = 0; vertex_id < vertices_count; vertex_id++) {
+    if (vertices_[vertex_id].parent_vertex_id ==
+        Graph::EdgeTable::kNoParentVertexId) {
+      depth_order.push_back(vertex_id);
+    }
+  }
+  for (size_t i = 0; i < depth_order.size(); i++) {
+    const auto& child_vertex_ids = vertices_[depth_order[i]].child_vertex_ids;
+    depth_order.insert(depth_order.end(), child_vertex_ids.begin(),
+                       child_vertex_ids.end());
+  }
+
+  auto new_vertex_ids = std::vector<VertexId>(vertices_count);
+  for (size_t i = 0; i < vertices_count; i++) {
+    new_vertex_ids[depth_order[i]] = graph.add_vertex();
+  }
+  for (const auto vertex_id : depth_order) {
+    const auto parent_vertex_id = vertices_[vertex_id].parent_vertex_id;
+    if (parent_vertex_id != Graph::EdgeTable::kNoParentVertexId) {
+      graph.add_edge(new_vertex_ids[parent_vertex_id],
+                     new_vertex_ids[vertex_id]);
+    }
+  }
+}
+
+ConcurrentGraph::VertexId ConcurrentGraph::create_vertex(
+    VertexId parent_vertex_id,
+    Depth depth) {
+  const VertexId vertex_id = vertices_count_.fetch_add(1);
+  if (vertex_id > Graph::EdgeTable::kMaxVertexId) {
+    throw std::overflow_error("Vertex ids are exhausted");
+  }
+
+  auto& vertex = vertices_[vertex_id];
+  vertex.parent_vertex_id = parent_vertex_id;
+  vertex.depth = depth;
+
+  auto& depth_bucket = depth_buckets_[depth];
+  {
+    const std::lock_guard lock(depth_bucket.mutex);
+    depth_bucket.vertex_ids.push_back(vertex_id);
+  }
+
+  auto current_depth = depth_.load();
+  while (current_depth < depth &&
+         !depth_.compare_exchange_weak(current_depth, depth)) {
+  }
+
+  return vertex_id;
+}
+}  // namespace uni_course_cpp
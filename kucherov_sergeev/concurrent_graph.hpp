@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "graph.hpp"
+#include "segmented_array.hpp"
+
+namespace uni_course_cpp {
+// Grey tree that many threads grow at once, without a graph wide mutex.
+// Vertex ids, and with them grey edge ids, are reserved from an atomic
+// counter, child lists sit behind striped locks and every depth bucket has a
+// lock of its own, so threads only meet when they touch the same vertex
+// stripe or the same depth. Once grown, the tree is copied into a Graph for
+// the remaining, non-grey edges.
+class ConcurrentGraph {
+ public:
+  using VertexId = Graph::VertexId;
+  using Depth = Graph::Depth;
+
+  ConcurrentGraph() = default;
+
+  ConcurrentGraph(const ConcurrentGraph& other) = delete;
+  ConcurrentGraph& operator=(const ConcurrentGraph& other) = delete;
+
+  // Adds a vertex without a parent at kGraphDefaultDepth.
+  VertexId add_vertex();
+
+  // Adds a vertex attached to the given one by a grey edge. The parent has
+  // to be added before the call, by this thread or a synchronized one.
+  VertexId add_vertex(VertexId parent_vertex_id);
+
+  // Counts the vertices whose ids were handed out, including those still
+  // being added by other threads.
+  size_t get_vertices_count() const;
+
+  Depth get_depth() const;
+
+  // The vertex has to be added by this thread or a synchronized one.
+  Depth get_vertex_depth(VertexId vertex_id) const;
+
+  // Snapshot of the vertices currently at the given depth, safe to take
+  // while other threads keep adding vertices.
+  std::vector<VertexId> get_depth_vertex_ids(Depth depth) const;
+
+  // Adds the tree to an empty graph in breadth-first order, so that every
+  // depth gets consecutive ids. Must not run concurrently with writers.
+  void copy_to(Graph& graph) const;
+
+ private:
+  struct VertexRecord {
+    VertexId parent_vertex_id = Graph::EdgeTable::kNoParentVertexId;
+    Depth depth = kGraphDefaultDepth;
+    std::vector<VertexId> child_vertex_ids;
+  };
+
+  struct DepthBucket {
+    mutable std::mutex mutex;
+    std::vector<VertexId> vertex_ids;
+  };
+
+  static constexpr size_t kStripesCount = 64;
+
+  VertexId create_vertex(VertexId parent_vertex_id, Depth depth);
+
+  std::atomic<size_t> vertices_count_ = 0;
+  std::atomic<Depth> depth_ = 0;
+  SegmentedArray<VertexRecord> vertices_;
+  SegmentedArray<DepthBucket> depth_buckets_;
+  std::array<std::mutex, kStripesCount> vertex_mutexes_;
+};
+}  // namespace uni_course_cpp
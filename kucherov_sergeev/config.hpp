@@ -8,6 +8,10 @@ namespace config {
 inline constexpr const char* kTempDirectoryPath = "./temp/";
 inline const std::string kLogFilename = "log.txt";
 inline const std::string kLogFilePath = kTempDirectoryPath + kLogFilename;
+// Segment files of the per-edge storage that generated graphs spill to
+// disk, see GraphGenerator::SpillMode.
+inline const std::string kEdgeSegmentsDirectoryPath =
+    kTempDirectoryPath + std::string("edges/");
 
 }  // namespace config
 }  // namespace uni_course_cpp
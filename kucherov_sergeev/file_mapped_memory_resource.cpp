@@ -0,0 +1,104 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "file_mapped_memory_resource.hpp"
+
+namespace uni_course_cpp {
+namespace {
+constexpr const char* kSegmentFileNameTemplate = "edges_XXXXXX";
+
+struct FileMappedArena {
+  explicit FileMappedArena(std::filesystem::path directory_path)
+      : segments(std::move(directory_path)),
+        arena(FileMappedMemoryResource::kMinSegmentBytes, &segments) {}
+
+  FileMappedMemoryResource segments;
+  std::pmr::monotonic_buffer_resource arena;
+};
+
+// Creates, sizes and maps a uniquely named segment file, which is unlinked
+// right away: the mapping keeps its storage alive.
+void* map_segment_file(const std::filesystem::path& directory_path,
+                       size_t bytes) {
+  const auto path_template =
+      (directory_path / kSegmentFileNameTemplate).string();
+  auto path = std::vector<char>(path_template.begin(), path_template.end());
+  path.push_back('\0');
+
+  const auto file_descriptor = mkstemp(path.data());
+  if (file_descriptor == -1) {
+    throw std::runtime_error("Can't create segment file in " +
+                             directory_path.string());
+  }
+  unlink(path.data());
+
+  if (ftruncate(file_descriptor, bytes) != 0) {
+    close(file_descriptor);
+    throw std::bad_alloc();
+  }
+  auto* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       file_descriptor, 0);
+  close(file_descriptor);
+  if (mapping == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+
+  return mapping;
+}
+}  // namespace
+
+FileMappedMemoryResource::FileMappedMemoryResource(
+    std::filesystem::path directory_path,
+    std::pmr::memory_resource* upstream)
+    : directory_path_(std::move(directory_path)), upstream_(upstream) {
+  std::filesystem::create_directories(directory_path_);
+}
+
+void* FileMappedMemoryResource::do_allocate(size_t bytes, size_t alignment) {
+  if (!is_mapped(bytes, alignment)) {
+    return upstream_->allocate(bytes, alignment);
+  }
+
+  auto* pointer = map_segment_file(directory_path_, bytes);
+  mapped_bytes_ += bytes;
+
+  return pointer;
+}
+
+void FileMappedMemoryResource::do_deallocate(void* pointer,
+                                             size_t bytes,
+                                             size_t alignment) {
+  if (!is_mapped(bytes, alignment)) {
+    upstream_->deallocate(pointer, bytes, alignment);
+    return;
+  }
+
+  munmap(pointer, bytes);
+  mapped_bytes_ -= bytes;
+}
+
+bool FileMappedMemoryResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+bool FileMappedMemoryResource::is_mapped(size_t bytes,
+                                         size_t alignment) const {
+  // Mappings are page aligned, which no allocation in the graph exceeds.
+  return bytes >= kMinSegmentBytes && alignment <= alignof(std::max_align_t);
+}
+
+std::shared_ptr<std::pmr::memory_resource> make_file_mapped_arena(
+    std::filesystem::path directory_path) {
+  const auto file_mapped_arena =
+      std::make_shared<FileMappedArena>(std::move(directory_path));
+  // Shares the ownership of the segments the arena allocates from.
+  return std::shared_ptr<std::pmr::memory_resource>(file_mapped_arena,
+                                                    &file_mapped_arena->arena);
+}
+}  // namespace uni_course_cpp
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+
+namespace uni_course_cpp {
+// Memory resource that keeps large arrays out of RAM. Every allocation of
+// at least kMinSegmentBytes is a segment file in the scratch directory,
+// mapped shared, so the kernel writes cold pages back to disk instead of
+// keeping them resident. Smaller allocations go to the upstream resource.
+// Segment files are unlinked as soon as they are mapped: their disk space
+// is released on deallocation, or by the kernel if the process dies.
+// Segments do not grow: a vector that outgrows one gets a new segment and
+// is copied into it, holding both until the copy is done, so containers
+// on this resource should be reserved up front. Segment files are sparse,
+// so reserving more than gets written costs address space, not disk.
+// Thread safe if the upstream is.
+class FileMappedMemoryResource : public std::pmr::memory_resource {
+ public:
+  static constexpr size_t kMinSegmentBytes = size_t(1) << 20;
+
+  // Creates the directory if it does not exist.
+  explicit FileMappedMemoryResource(std::filesystem::path directory_path)
+      : FileMappedMemoryResource(std::move(directory_path),
+                                 std::pmr::get_default_resource()) {}
+  FileMappedMemoryResource(std::filesystem::path directory_path,
+                           std::pmr::memory_resource* upstream);
+
+  FileMappedMemoryResource(const FileMappedMemoryResource& other) = delete;
+  FileMappedMemoryResource& operator=(const FileMappedMemoryResource& other) =
+      delete;
+
+  // Bytes currently held in segment files.
+  size_t get_mapped_bytes() const { return mapped_bytes_; }
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource& other) const
+      noexcept override;
+
+  bool is_mapped(size_t bytes, size_t alignment) const;
+
+  std::filesystem::path directory_path_;
+  std::pmr::memory_resource* upstream_ = nullptr;
+  std::atomic<size_t> mapped_bytes_ = 0;
+};
+
+// Monotonic arena whose chunks are all segment files, so that small
+// containers, adjacency lists for instance, are kept out of RAM as well as
+// large ones. The arena owns its segments and unmaps them when destroyed,
+// not before, so large containers still have to be reserved up front.
+// Not thread safe.
+std::shared_ptr<std::pmr::memory_resource> make_file_mapped_arena(
+    std::filesystem::path directory_path);
+}  // namespace uni_course_cpp
@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "frozen_graph.hpp"
+#include "parallel_for.hpp"
+
+namespace uni_course_cpp {
+namespace {
+// Smaller ranges cost more to hand to a thread than to sort in place.
+constexpr size_t kMinItemsPerRange = 1 << 16;
+// Depth 0 is never populated, so it is free to mark vertices whose depth is
+// not known yet.
+constexpr Graph::Depth kUnknownDepth = 0;
+constexpr Graph::Depth kVisitingDepth = -1;
+
+// Depth difference Graph::add_edge gives an edge of the color, the one a
+// green loop has included.
+Graph::Depth get_color_depth_difference(Graph::Edge::Color color) {
+  switch (color) {
+    case Graph::Edge::Color::Grey:
+    case Graph::Edge::Color::Yellow:
+      return 1;
+    case Graph::Edge::Color::Red:
+      return 2;
+    case Graph::Edge::Color::Green:
+      return 0;
+  }
+  throw std::runtime_error("Edge has an unknown color");
+}
+
+// Stable counting sort of the entries produced by items into buckets.
+// for_each_entry(item, emit) calls emit(bucket, value) for every entry of an
+// item. Every parallel_for() range keeps its own bucket counters, so no
+// writes are shared. Bucket b receives its values at
+// [offsets[b], offsets[b + 1]), after leading_counts[b] slots left for the
+// caller to fill.
+template <typename Value, typename ForEachEntry>
+void parallel_counting_sort(size_t items_count,
+                            const std::vector<size_t>& leading_counts,
+                            const ForEachEntry& for_each_entry,
+                            std::vector<size_t>& offsets,
+                            std::vector<Value>& values) {
+  const auto buckets_count = leading_counts.size();
+  const auto ranges_count =
+      get_parallel_ranges_count(items_count, kMinItemsPerRange);
+
+  auto range_positions = std::vector<std::vector<size_t>>(
+      ranges_count, std::vector<size_t>(buckets_count, 0));
+  parallel_for(items_count, kMinItemsPerRange,
+               [&range_positions, &for_each_entry](size_t range, size_t begin,
+                                                   size_t end) {
+                 auto& counts = range_positions[range];
+                 for (auto item = begin; item < end; item++) {
+                   for_each_entry(item, [&counts](size_t bucket, const Value&) {
+                     counts[bucket]++;
+                   });
+                 }
+               });
+
+  // Inside every bucket the leading slots go first, then the entries of
+  // every range in item order, which keeps the sort stable.
+  offsets.assign(buckets_count + 1, 0);
+  size_t position = 0;
+  for (size_t bucket = 0; bucket < buckets_count; bucket++) {
+    offsets[bucket] = position;
+    position += leading_counts[bucket];
+    for (auto& positions : range_positions) {
+      const auto count = positions[bucket];
+      positions[bucket] = position;
+      position += count;
+    }
+  }
+  offsets[buckets_count] = position;
+  values.resize(position);
+
+  parallel_for(
+      items_count, kMinItemsPerRange,
+      [&range_positions, &for_each_entry, &values](size_t range, size_t begin,
+                                                   size_t end) {
+        auto& positions = range_positions[range];
+        for (auto item = begin; item < end; item++) {
+          for_each_entry(
+              item, [&positions, &values](size_t bucket, const Value& value) {
+                values[positions[bucket]++] = value;
+              });
+        }
+      });
+}
+}  // namespace
+
+FrozenGraph::FrozenGraph(const Graph& graph) : edges_(graph.get_edges()) {
+  if (graph.has_removed_entries()) {
+    throw std::logic_error("Graph has pending removals, compact it first");
+  }
+
+  const auto depth_order = graph.get_depth_order();
+  const auto vertices_count = depth_order.size();
+
+  auto new_vertex_ids = std::vector<VertexId>(vertices_count);
+  for (size_t i = 0; i < vertices_count; i++) {
+    new_vertex_ids[depth_order[i]] = i;
+  }
+  edges_.relabel_vertices(new_vertex_ids);
+
+  const auto depth = graph.get_depth();
+  depth_offsets_.assign(depth + 2, 0);
+  vertices_.reserve(vertices_count);
+  vertex_depths_list_.reserve(vertices_count);
+  for (size_t i = 0; i < vertices_count; i++) {
+    const auto vertex_depth = graph.get_vertex_depth(depth_order[i]);
+    vertices_.emplace_back(i);
+    vertex_depths_list_.push_back(vertex_depth);
+    depth_offsets_[vertex_depth + 1]++;
+  }
+  for (Depth current_depth = 1; current_depth <= depth + 1; current_depth++) {
+    depth_offsets_[current_depth] += depth_offsets_[current_depth - 1];
+  }
+
+  depth_color_edges_counts_.resize(depth + 1);
+  for (Depth current_depth = 0; current_depth <= depth; current_depth++) {
+    for (int color = 0; color < Edge::kColorsCount; color++) {
+      depth_color_edges_counts_[current_depth][color] =
+          graph.get_depth_color_edges_count(current_depth,
+                                            static_cast<Edge::Color>(color));
+    }
+  }
+
+  // Every vertex keeps the edge order Graph reports, including its own grey
+  // edge that Graph does not store in the adjacency list.
+  adjacency_offsets_.reserve(vertices_count + 1);
+  adjacency_edge_ids_.reserve(2 * edges_.size());
+  adjacency_offsets_.push_back(0);
+  for (const auto vertex_id : depth_order) {
+    for (const auto edge_id : graph.get_connected_edge_ids(vertex_id)) {
+      adjacency_edge_ids_.push_back(
+          EdgeTable::relabel_edge_id(edge_id, new_vertex_ids));
+    }
+    adjacency_offsets_.push_back(adjacency_edge_ids_.size());
+  }
+}
+
+FrozenGraph::FrozenGraph(size_t vertices_count, Span<const EdgeRecord> edges) {
+  // A vertex whose very first edge is a loop is pushed one level down, the
+  // way Graph::add_edge does it.
+  auto parent_vertex_ids =
+      std::vector<VertexId>(vertices_count, EdgeTable::kNoParentVertexId);
+  auto has_edges = std::vector<bool>(vertices_count, false);
+  auto is_lowered = std::vector<bool>(vertices_count, false);
+  for (const auto& edge : edges) {
+    if (edge.from_vertex_id >= vertices_count ||
+        edge.to_vertex_id >= vertices_count) {
+      throw std::runtime_error("Edge refers to a missing vertex");
+    }
+    if ((edge.color == Edge::Color::Green) !=
+        (edge.from_vertex_id == edge.to_vertex_id)) {
+      throw std::runtime_error("Only green edges are loops");
+    }
+    if (edge.color == Edge::Color::Grey) {
+      if (parent_vertex_ids[edge.to_vertex_id] !=
+          EdgeTable::kNoParentVertexId) {
+        throw std::runtime_error("Vertex has an invalid grey edge");
+      }
+      parent_vertex_ids[edge.to_vertex_id] = edge.from_vertex_id;
+    }
+    if (edge.from_vertex_id == edge.to_vertex_id &&
+        !has_edges[edge.from_vertex_id]) {
+      is_lowered[edge.from_vertex_id] = true;
+    }
+    has_edges[edge.from_vertex_id] = true;
+    has_edges[edge.to_vertex_id] = true;
+  }
+
+  auto vertex_depths = std::vector<Depth>(vertices_count, kUnknownDepth);
+  auto path = std::vector<VertexId>();
+  for (VertexId vertex_id = 0; vertex_id < vertices_count; vertex_id++) {
+    auto ancestor_id = vertex_id;
+    path.clear();
+    while (vertex_depths[ancestor_id] == kUnknownDepth &&
+           parent_vertex_ids[ancestor_id] != EdgeTable::kNoParentVertexId) {
+      vertex_depths[ancestor_id] = kVisitingDepth;
+      path.push_back(ancestor_id);
+      ancestor_id = parent_vertex_ids[ancestor_id];
+    }
+    if (vertex_depths[ancestor_id] == kVisitingDepth) {
+      throw std::runtime_error("Grey edges form a cycle");
+    }
+    if (vertex_depths[ancestor_id] == kUnknownDepth) {
+      vertex_depths[ancestor_id] =
+          kGraphDefaultDepth + (is_lowered[ancestor_id] ? 1 : 0);
+    }
+
+    auto depth = vertex_depths[ancestor_id];
+    for (auto it = path.rbegin(); it != path.rend(); it++) {
+      vertex_depths[*it] = ++depth;
+    }
+  }
+
+  // Graph::add_edge only draws a grey edge to a vertex with no edges yet, so
+  // a lowered vertex never has a grey parent. The grey chains already put
+  // every grey edge one level down, the other colors are checked here.
+  for (const auto& edge : edges) {
+    if (edge.color == Edge::Color::Grey && is_lowered[edge.to_vertex_id]) {
+      throw std::runtime_error("Grey edge is not a tree edge");
+    }
+    if (vertex_depths[edge.to_vertex_id] -
+            vertex_depths[edge.from_vertex_id] !=
+        get_color_depth_difference(edge.color)) {
+      throw std::runtime_error("Edge color does not match vertex depths");
+    }
+  }
+
+  const auto depth =
+      vertex_depths.empty()
+          ? 0
+          : *std::max_element(vertex_depths.begin(), vertex_depths.end());
+
+  auto depth_order = std::vector<VertexId>();
+  auto depth_offsets = std::vector<size_t>();
+  parallel_counting_sort<VertexId>(
+      vertices_count, std::vector<size_t>(depth + 1, 0),
+      [&vertex_depths](size_t vertex_id, const auto& emit) {
+        emit(vertex_depths[vertex_id], vertex_id);
+      },
+      depth_offsets, depth_order);
+  depth_offsets_.assign(depth_offsets.begin(), depth_offsets.end());
+
+  auto new_vertex_ids = std::vector<VertexId>(vertices_count);
+  vertices_.reserve(vertices_count);
+  vertex_depths_list_.reserve(vertices_count);
+  for (size_t i = 0; i < vertices_count; i++) {
+    new_vertex_ids[depth_order[i]] = i;
+    vertices_.emplace_back(i);
+    vertex_depths_list_.push_back(vertex_depths[depth_order[i]]);
+  }
+
+  depth_color_edges_counts_.resize(depth + 1);
+  auto edge_ids = std::vector<EdgeId>();
+  edge_ids.reserve(edges.size());
+  for (size_t i = 0; i < vertices_count; i++) {
+    edges_.add_vertex();
+  }
+  for (const auto& edge : edges) {
+    edge_ids.push_back(edges_.add_edge(new_vertex_ids[edge.from_vertex_id],
+                                       new_vertex_ids[edge.to_vertex_id],
+                                       edge.color));
+    depth_color_edges_counts_[vertex_depths[edge.from_vertex_id]]
+                             [static_cast<int>(edge.color)]++;
+  }
+
+  // The own grey edge of a vertex takes the leading slot of its list.
+  auto leading_counts = std::vector<size_t>(vertices_count, 0);
+  for (VertexId vertex_id = 0; vertex_id < vertices_count; vertex_id++) {
+    leading_counts[vertex_id] = edges_.has_grey_edge(vertex_id) ? 1 : 0;
+  }
+  parallel_counting_sort<EdgeId>(
+      edges.size(), leading_counts,
+      [this, &edges, &edge_ids](size_t edge_index, const auto& emit) {
+        const auto edge_id = edge_ids[edge_index];
+        const auto from_vertex_id = edges_.from_vertex_id(edge_id);
+        const auto to_vertex_id = edges_.to_vertex_id(edge_id);
+        emit(from_vertex_id, edge_id);
+        if (to_vertex_id != from_vertex_id &&
+            edges[edge_index].color != Edge::Color::Grey) {
+          emit(to_vertex_id, edge_id);
+        }
+      },
+      adjacency_offsets_, adjacency_edge_ids_);
+  for (VertexId vertex_id = 0; vertex_id < vertices_count; vertex_id++) {
+    if (leading_counts[vertex_id] != 0) {
+      adjacency_edge_ids_[adjacency_offsets_[vertex_id]] =
+          EdgeTable::grey_edge_id(vertex_id);
+    }
+  }
+}
+
+FrozenGraph::Depth FrozenGraph::get_depth() const {
+  return depth_offsets_.size() - 2;
+}
+
+size_t FrozenGraph::get_depth_vertices_count(Depth depth) const {
+  if (depth < 0 || depth > get_depth()) {
+    return 0;
+  }
+
+  return depth_offsets_[depth + 1] - depth_offsets_[depth];
+}
+
+size_t FrozenGraph::get_depth_color_edges_count(Depth depth,
+                                                Edge::Color color) const {
+  if (depth < 0 || depth > get_depth()) {
+    return 0;
+  }
+
+  return depth_color_edges_counts_[depth][static_cast<int>(color)];
+}
+
+IdRange<FrozenGraph::VertexId> FrozenGraph::get_depth_vertex_ids(
+    Depth depth) const {
+  if (depth < 0 || depth > get_depth()) {
+    return {};
+  }
+
+  return {depth_offsets_[depth], depth_offsets_[depth + 1]};
+}
+
+Span<const FrozenGraph::EdgeId> FrozenGraph::get_connected_edge_ids(
+    VertexId vertex_id) const {
+  if (vertex_id >= vertices_.size()) {
+    return {};
+  }
+
+  return {adjacency_edge_ids_.data() + adjacency_offsets_[vertex_id],
+          adjacency_edge_ids_.data() + adjacency_offsets_[vertex_id + 1]};
+}
+
+bool FrozenGraph::is_vertices_connected(VertexId first_vertex_id,
+                                        VertexId second_vertex_id) const {
+  for (const auto edge_id : get_connected_edge_ids(first_vertex_id)) {
+    const auto from_vertex_id = edges_.from_vertex_id(edge_id);
+    const auto to_vertex_id = edges_.to_vertex_id(edge_id);
+    if ((first_vertex_id == from_vertex_id &&
+         second_vertex_id == to_vertex_id) ||
+        (first_vertex_id == to_vertex_id &&
+         second_vertex_id == from_vertex_id)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+FrozenGraph::Depth FrozenGraph::get_vertex_depth(VertexId vertex_id) const {
+  return vertex_depths_list_.at(vertex_id);
+}
+
+const std::vector<FrozenGraph::Vertex>& FrozenGraph::get_vertices() const {
+  return vertices_;
+}
+
+const FrozenGraph::EdgeTable& FrozenGraph::get_edges() const {
+  return edges_;
+}
+}  // namespace uni_course_cpp
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "graph.hpp"
+#include "id_range.hpp"
+#include "span.hpp"
+
+namespace uni_course_cpp {
+// Immutable snapshot of a Graph in compressed sparse row form. Connected edge
+// ids of every vertex are stored back to back in a single array, sliced by an
+// offsets array. Vertices are numbered in Graph::get_depth_order() order, so
+// every depth is a range of consecutive ids and needs no storage of its own.
+class FrozenGraph {
+ public:
+  using VertexId = Graph::VertexId;
+  using EdgeId = Graph::EdgeId;
+  using Depth = Graph::Depth;
+  using Vertex = Graph::Vertex;
+  using Edge = Graph::Edge;
+  using EdgeTable = Graph::EdgeTable;
+
+  // Edge as listed in stored outputs, the input of the bulk constructor.
+  struct EdgeRecord {
+    VertexId from_vertex_id = 0;
+    VertexId to_vertex_id = 0;
+    Edge::Color color = Edge::Color::Grey;
+  };
+
+  explicit FrozenGraph(const Graph& graph);
+
+  // Builds the snapshot straight from an edge list, trusting the listed
+  // colors instead of inserting and recoloring edges one at a time. Vertex
+  // depths follow the chains of grey edges, and every connected edge ids
+  // list keeps the input order after the vertex's own grey edge. Both the
+  // depth ranges and the adjacency arrays come out of a parallel counting
+  // sort. Throws std::runtime_error when the grey edges do not form a forest
+  // or a color does not match the vertex depths: green for loops only,
+  // yellow one level down and red two. Whether a yellow edge duplicates an
+  // earlier one is not checked.
+  FrozenGraph(size_t vertices_count, Span<const EdgeRecord> edges);
+
+  Depth get_depth() const;
+
+  size_t get_depth_vertices_count(Depth depth) const;
+  size_t get_depth_color_edges_count(Depth depth, Edge::Color color) const;
+
+  IdRange<VertexId> get_depth_vertex_ids(Depth depth) const;
+
+  Span<const EdgeId> get_connected_edge_ids(VertexId vertex_id) const;
+
+  bool is_vertices_connected(VertexId first_vertex_id,
+                             VertexId second_vertex_id) const;
+
+  Depth get_vertex_depth(VertexId vertex_id) const;
+
+  const std::vector<Vertex>& get_vertices() const;
+
+  const EdgeTable& get_edges() const;
+
+ private:
+  std::vector<Vertex> vertices_;
+  EdgeTable edges_;
+  std::vector<Depth> vertex_depths_list_;
+  std::vector<size_t> adjacency_offsets_;
+  std::vector<EdgeId> adjacency_edge_ids_;
+  std::vector<VertexId> depth_offsets_;
+  std::vector<std::array<size_t, Edge::kColorsCount>>
+      depth_color_edges_counts_;
+};
+}  // namespace uni_course_cpp
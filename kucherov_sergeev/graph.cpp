@@ -1,99 +1,1182 @@
 #include <algorithm>
+#include <cassert>
+#include <numeric>
 #include <stdexcept>
+#include <utility>
+#include <variant>
 
+#include "frozen_graph.hpp"
 #include "graph.hpp"
+#include "parallel_for.hpp"
 
 namespace uni_course_cpp {
+namespace {
+template <typename Vector>
+size_t get_capacity_bytes(const Vector& vector) {
+  return vector.capacity() * sizeof(typename Vector::value_type);
+}
+
+template <typename Vector>
+size_t get_nested_capacity_bytes(const Vector& vector) {
+  auto bytes = get_capacity_bytes(vector);
+  for (const auto& nested_vector : vector) {
+    bytes += get_capacity_bytes(nested_vector);
+  }
+  return bytes;
+}
+
+size_t get_tombstones_bytes(const std::pmr::vector<bool>& tombstones) {
+  return tombstones.capacity() / 8;
+}
+
+// Smaller ranges cost more to hand to a thread than to process in place.
+constexpr size_t kMinItemsPerThread = 1 << 16;
+
+// Numbers the kept items densely in their order, in parallel, and gives the
+// others removed_id. Every range counts its kept items first, so that the
+// second pass numbers each range from the total of the ranges before it.
+// Returns the number of kept items.
+template <typename Id, typename IsKept>
+size_t number_kept_items(size_t items_count,
+                         const IsKept& is_kept,
+                         Id removed_id,
+                         std::vector<Id>& new_ids) {
+  const auto ranges_count =
+      get_parallel_ranges_count(items_count, kMinItemsPerThread);
+  auto range_offsets = std::vector<size_t>(ranges_count + 1, 0);
+  parallel_for(items_count, kMinItemsPerThread,
+               [&is_kept, &range_offsets](size_t range, size_t begin,
+                                          size_t end) {
+                 size_t kept_count = 0;
+                 for (auto item = begin; item < end; item++) {
+                   kept_count += is_kept(item) ? 1 : 0;
+                 }
+                 range_offsets[range + 1] = kept_count;
+               });
+  std::partial_sum(range_offsets.begin(), range_offsets.end(),
+                   range_offsets.begin());
+
+  new_ids.resize(items_count);
+  parallel_for(items_count, kMinItemsPerThread,
+               [&is_kept, removed_id, &range_offsets, &new_ids](
+                   size_t range, size_t begin, size_t end) {
+                 auto next_id = range_offsets[range];
+                 for (auto item = begin; item < end; item++) {
+                   new_ids[item] = is_kept(item) ? next_id++ : removed_id;
+                 }
+               });
+
+  return range_offsets[ranges_count];
+}
+
+// Merging runs one range of graphs per thread. Ranges hold enough graphs for
+// kMinItemsPerThread items on average, so small merges stay on one thread.
+size_t get_min_graphs_per_range(size_t graphs_count, size_t items_count) {
+  return std::max<size_t>(
+      graphs_count * kMinItemsPerThread / std::max<size_t>(items_count, 1), 1);
+}
+
+// Copies a property of one merged graph into the property of the same name
+// in the result, which is added first if missing. Source ids map to
+// new_id(id), PropertyMap::kDroppedId for ids out of the graph.
+// for_each_id(function) calls function with every id of the graph. It is
+// only needed when the default values differ, else unset values are left
+// for the default to cover.
+template <typename T, typename NewId, typename ForEachId>
+void merge_property(PropertyMaps& properties,
+                    const std::string& name,
+                    const PropertyMap<T>& property,
+                    std::pmr::memory_resource* memory_resource,
+                    const NewId& new_id,
+                    const ForEachId& for_each_id) {
+  auto* merged_property =
+      (properties.count(name) == 0)
+          ? &add_property(properties, name, property.get_default_value(),
+                          memory_resource)
+          : &get_property<T>(properties, name);
+
+  const auto copy_value = [merged_property, &property, &new_id](size_t id) {
+    const auto merged_id = new_id(id);
+    if (merged_id != PropertyMap<T>::kDroppedId) {
+      merged_property->set(merged_id, property[id]);
+    }
+  };
+  if (merged_property->get_default_value() == property.get_default_value()) {
+    for (size_t id = 0; id < property.size(); id++) {
+      copy_value(id);
+    }
+  } else {
+    for_each_id(copy_value);
+  }
+}
+}  // namespace
+
+Graph::Graph(std::pmr::memory_resource* memory_resource)
+    : Graph(memory_resource, Indices()) {}
+
+Graph::Graph(std::pmr::memory_resource* memory_resource,
+             const Indices& indices)
+    : Graph(memory_resource, indices, memory_resource) {}
+
+Graph::Graph(std::pmr::memory_resource* memory_resource,
+             const Indices& indices,
+             std::pmr::memory_resource* edges_memory_resource)
+    : indices_(indices),
+      vertices_(memory_resource),
+      edges_(edges_memory_resource),
+      adjacency_list_(edges_memory_resource),
+      neighbor_sets_(edges_memory_resource),
+      vertex_depths_list_(memory_resource),
+      depth_vertices_list_(1, memory_resource),
+      vertex_depth_positions_(memory_resource),
+      depth_vertices_capacities_(memory_resource),
+      depth_vertices_counts_(1, memory_resource),
+      depth_color_edges_counts_(1, memory_resource),
+      removed_vertices_(memory_resource) {}
+
+Graph::Graph(std::shared_ptr<std::pmr::memory_resource> memory_resource)
+    : Graph(std::move(memory_resource), Indices()) {}
+
+Graph::Graph(std::shared_ptr<std::pmr::memory_resource> memory_resource,
+             const Indices& indices)
+    : Graph(memory_resource.get(), indices) {
+  owned_memory_resource_ = std::move(memory_resource);
+}
+
+Graph::Graph(std::shared_ptr<std::pmr::memory_resource> memory_resource,
+             const Indices& indices,
+             std::shared_ptr<std::pmr::memory_resource> edges_memory_resource)
+    : Graph(memory_resource.get(), indices, edges_memory_resource.get()) {
+  owned_memory_resource_ = std::move(memory_resource);
+  owned_edges_memory_resource_ = std::move(edges_memory_resource);
+}
+
+Graph::Graph(const Graph& other,
+             std::shared_ptr<std::pmr::memory_resource> memory_resource,
+             std::shared_ptr<std::pmr::memory_resource> edges_memory_resource)
+    : Graph(std::move(memory_resource),
+            other.indices_,
+            std::move(edges_memory_resource)) {
+  // Assignment keeps the allocators of the assigned-to containers, and
+  // nested containers get them too.
+  next_free_vertex_id_ = other.next_free_vertex_id_;
+  vertices_ = other.vertices_;
+  edges_ = other.edges_;
+  adjacency_list_ = other.adjacency_list_;
+  neighbor_sets_ = other.neighbor_sets_;
+  vertex_depths_list_ = other.vertex_depths_list_;
+  depth_vertices_list_ = other.depth_vertices_list_;
+  vertex_depth_positions_ = other.vertex_depth_positions_;
+  depth_vertices_capacities_ = other.depth_vertices_capacities_;
+  depth_vertices_counts_ = other.depth_vertices_counts_;
+  depth_color_edges_counts_ = other.depth_color_edges_counts_;
+  vertex_properties_ =
+      copy_properties(other.vertex_properties_, get_memory_resource());
+  edge_properties_ =
+      copy_properties(other.edge_properties_, get_memory_resource());
+  removed_vertices_ = other.removed_vertices_;
+  removed_vertices_count_ = other.removed_vertices_count_;
+}
+
+Graph Graph::copy_to_new_arena() const {
+  auto* memory_resource = get_memory_resource();
+  const auto* arena =
+      dynamic_cast<const std::pmr::monotonic_buffer_resource*>(memory_resource);
+  const auto new_arena = std::shared_ptr<std::pmr::memory_resource>(
+      std::make_shared<std::pmr::monotonic_buffer_resource>(
+          arena ? arena->upstream_resource() : memory_resource));
+
+  auto* edges_memory_resource = edges_.get_memory_resource();
+  if (edges_memory_resource == memory_resource) {
+    return Graph(*this, new_arena, new_arena);
+  }
+  // Resources passed by pointer are not owned and have to outlive the
+  // copy as well.
+  const auto shared_edges_memory_resource =
+      owned_edges_memory_resource_
+          ? owned_edges_memory_resource_
+          : std::shared_ptr<std::pmr::memory_resource>(std::shared_ptr<void>(),
+                                                       edges_memory_resource);
+  return Graph(*this, new_arena, shared_edges_memory_resource);
+}
+
+const Graph::Indices& Graph::get_indices() const {
+  return indices_;
+}
+
+size_t Graph::get_depth_vertices_count(Graph::Depth depth) const {
+  if (depth < 0 || depth > get_depth()) {
+    return 0;
+  }
+  return depth_vertices_counts_[depth];
+}
+
+size_t Graph::get_depth_color_edges_count(Graph::Depth depth,
+                                          Graph::Edge::Color color) const {
+  if (depth < 0 || depth > get_depth()) {
+    return 0;
+  }
+  return depth_color_edges_counts_[depth][static_cast<int>(color)];
+}
+
+void Graph::reserve(const Capacity& capacity) {
+  vertices_.reserve(capacity.vertices_count);
+  edges_.reserve(capacity.vertices_count, capacity.non_grey_edges_count);
+  adjacency_list_.reserve(capacity.vertices_count);
+  vertex_depths_list_.reserve(capacity.vertices_count);
+  if (indices_.neighbor_sets) {
+    neighbor_sets_.reserve(capacity.vertices_count);
+  }
+  if (!indices_.depth_buckets) {
+    return;
+  }
+
+  vertex_depth_positions_.reserve(capacity.vertices_count);
+  depth_vertices_capacities_.assign(capacity.depth_vertices_counts.begin(),
+                                    capacity.depth_vertices_counts.end());
+  depth_vertices_list_.reserve(depth_vertices_capacities_.size());
+  for (size_t depth = 0; depth < depth_vertices_list_.size() &&
+                         depth < depth_vertices_capacities_.size();
+       depth++) {
+    depth_vertices_list_[depth].reserve(depth_vertices_capacities_[depth]);
+  }
+}
+
 Graph::VertexId Graph::add_vertex() {
   const VertexId vertex_id = get_new_vertex_id();
 
-  vertices_.insert({vertex_id, Graph::Vertex(vertex_id)});
-  set_vertex_depth(vertex_id, kGraphDefaultDepth);
+  vertices_.emplace_back(vertex_id);
+  edges_.add_vertex();
+  adjacency_list_.emplace_back();
+  if (indices_.neighbor_sets) {
+    neighbor_sets_.emplace_back();
+  }
+  vertex_depths_list_.push_back(kGraphDefaultDepth);
+  while (get_depth() < kGraphDefaultDepth) {
+    add_depth();
+  }
+  depth_vertices_counts_[kGraphDefaultDepth]++;
+  if (indices_.depth_buckets) {
+    vertex_depth_positions_.push_back(
+        depth_vertices_list_[kGraphDefaultDepth].size());
+    depth_vertices_list_[kGraphDefaultDepth].push_back(vertex_id);
+  }
 
   return vertex_id;
 }
 
 Graph::EdgeId Graph::add_edge(Graph::VertexId from_vertex_id,
                               Graph::VertexId to_vertex_id) {
+  if (has_removed_entries()) {
+    throw std::logic_error("Graph has pending removals, compact it first");
+  }
   if (get_connected_edge_ids(to_vertex_id).empty()) {
     set_vertex_depth(to_vertex_id, get_vertex_depth(from_vertex_id) + 1);
   }
 
-  const auto edge_id = get_new_edge_id();
   const auto edge_color = determine_edge_color(from_vertex_id, to_vertex_id);
-
-  edges_.insert({edge_id, Graph::Edge(edge_id, from_vertex_id, to_vertex_id,
-                                      edge_color)});
+  const auto edge_id =
+      edges_.add_edge(from_vertex_id, to_vertex_id, edge_color);
+  depth_color_edges_counts_[get_vertex_depth(from_vertex_id)]
+                           [static_cast<int>(edge_color)]++;
 
   adjacency_list_[from_vertex_id].push_back(edge_id);
-  if (to_vertex_id != from_vertex_id) {
+  if (to_vertex_id != from_vertex_id &&
+      edge_color != Graph::Edge::Color::Grey) {
     adjacency_list_[to_vertex_id].push_back(edge_id);
   }
+  if (indices_.neighbor_sets) {
+    neighbor_sets_[from_vertex_id].insert(to_vertex_id);
+    neighbor_sets_[to_vertex_id].insert(from_vertex_id);
+  }
 
   return edge_id;
 }
 
+void Graph::remove_edge(Graph::EdgeId edge_id) {
+  if (!edges_.contains(edge_id)) {
+    throw std::invalid_argument("Edge does not exist or is removed");
+  }
+
+  // The source of an edge keeps its depth once the edge is added, so this is
+  // the depth the edge was counted at.
+  depth_color_edges_counts_[get_vertex_depth(edges_.from_vertex_id(edge_id))]
+                           [static_cast<int>(edges_.color(edge_id))]--;
+  edges_.remove_edge(edge_id);
+}
+
+void Graph::remove_vertex(Graph::VertexId vertex_id) {
+  if (vertex_id >= next_free_vertex_id_ || is_vertex_removed(vertex_id)) {
+    throw std::invalid_argument("Vertex does not exist or is removed");
+  }
+
+  for (const auto edge_id : get_connected_edge_ids(vertex_id)) {
+    if (!edges_.is_removed(edge_id)) {
+      remove_edge(edge_id);
+    }
+  }
+
+  if (vertex_id >= removed_vertices_.size()) {
+    removed_vertices_.resize(vertices_.size(), false);
+  }
+  removed_vertices_[vertex_id] = true;
+  removed_vertices_count_++;
+  depth_vertices_counts_[get_vertex_depth(vertex_id)]--;
+}
+
+bool Graph::is_vertex_removed(Graph::VertexId vertex_id) const {
+  return vertex_id < removed_vertices_.size() && removed_vertices_[vertex_id];
+}
+
+bool Graph::has_removed_entries() const {
+  return removed_vertices_count_ != 0 || edges_.has_removed_edges();
+}
+
+Graph Graph::merge(Span<const Graph> graphs) {
+  auto graph_pointers = std::vector<const Graph*>();
+  graph_pointers.reserve(graphs.size());
+  for (const auto& graph : graphs) {
+    graph_pointers.push_back(&graph);
+  }
+  return merge(Span<const Graph* const>(graph_pointers));
+}
+
+Graph Graph::merge(Span<const Graph* const> graphs) {
+  const auto graphs_count = graphs.size();
+  const auto indices = graphs.empty() ? Indices() : graphs[0]->indices_;
+  auto vertex_offsets = std::vector<size_t>(graphs_count + 1, 0);
+  auto explicit_edge_offsets = std::vector<size_t>(graphs_count + 1, 0);
+  auto edge_tables = std::vector<const EdgeTable*>(graphs_count);
+  Depth depth = 0;
+  for (size_t i = 0; i < graphs_count; i++) {
+    const auto& graph = *graphs[i];
+    if (graph.has_removed_entries()) {
+      throw std::logic_error("Graph has pending removals, compact it first");
+    }
+    if (graph.indices_.neighbor_sets != indices.neighbor_sets ||
+        graph.indices_.depth_buckets != indices.depth_buckets) {
+      throw std::invalid_argument("Merged graphs have different indices");
+    }
+    vertex_offsets[i + 1] = vertex_offsets[i] + graph.vertices_.size();
+    explicit_edge_offsets[i + 1] =
+        explicit_edge_offsets[i] + graph.edges_.get_explicit_edges_count();
+    edge_tables[i] = &graph.edges_;
+    depth = std::max(depth, graph.get_depth());
+  }
+  const auto vertices_count = vertex_offsets.back();
+  if (vertices_count > static_cast<size_t>(EdgeTable::kMaxVertexId) + 1) {
+    throw std::overflow_error("Vertex ids are exhausted");
+  }
+  if (explicit_edge_offsets.back() > EdgeTable::kMaxExplicitEdgesCount) {
+    throw std::overflow_error("Edge ids are exhausted");
+  }
+
+  auto merged_graph = Graph(std::pmr::get_default_resource(), indices);
+  merged_graph.edges_.merge(edge_tables, vertex_offsets,
+                            explicit_edge_offsets);
+  merged_graph.next_free_vertex_id_ = vertices_count;
+  while (merged_graph.get_depth() < depth) {
+    merged_graph.add_depth();
+  }
+
+  // Summary counters add up, and every depth bucket is the concatenation of
+  // the graphs' buckets, which sets where each graph writes into it.
+  auto depth_vertex_offsets = std::vector<std::vector<size_t>>(
+      graphs_count, std::vector<size_t>(depth + 1));
+  for (size_t i = 0; i < graphs_count; i++) {
+    const auto& graph = *graphs[i];
+    for (Depth vertex_depth = 0; vertex_depth <= graph.get_depth();
+         vertex_depth++) {
+      depth_vertex_offsets[i][vertex_depth] =
+          merged_graph.depth_vertices_counts_[vertex_depth];
+      merged_graph.depth_vertices_counts_[vertex_depth] +=
+          graph.depth_vertices_counts_[vertex_depth];
+      for (int color = 0; color < Edge::kColorsCount; color++) {
+        merged_graph.depth_color_edges_counts_[vertex_depth][color] +=
+            graph.depth_color_edges_counts_[vertex_depth][color];
+      }
+    }
+  }
+
+  // Containers are allocated here, as the memory resource of a graph need
+  // not be thread safe, and only filled by the threads below.
+  merged_graph.vertices_.resize(vertices_count, Vertex(0));
+  merged_graph.vertex_depths_list_.resize(vertices_count);
+  merged_graph.adjacency_list_.resize(vertices_count);
+  for (size_t i = 0; i < graphs_count; i++) {
+    const auto& adjacency_list = graphs[i]->adjacency_list_;
+    for (size_t vertex_id = 0; vertex_id < adjacency_list.size(); vertex_id++) {
+      merged_graph.adjacency_list_[vertex_offsets[i] + vertex_id].reserve(
+          adjacency_list[vertex_id].size());
+    }
+  }
+  if (indices.depth_buckets) {
+    merged_graph.vertex_depth_positions_.resize(vertices_count);
+    for (Depth vertex_depth = 0; vertex_depth <= depth; vertex_depth++) {
+      merged_graph.depth_vertices_list_[vertex_depth].resize(
+          merged_graph.depth_vertices_counts_[vertex_depth]);
+    }
+  }
+
+  parallel_for(
+      graphs_count, get_min_graphs_per_range(graphs_count, vertices_count),
+      [&merged_graph, &graphs, &vertex_offsets, &explicit_edge_offsets,
+       &depth_vertex_offsets](size_t, size_t begin, size_t end) {
+        for (auto i = begin; i < end; i++) {
+          const auto& graph = *graphs[i];
+          const auto vertex_offset = vertex_offsets[i];
+          const auto explicit_edge_offset = explicit_edge_offsets[i];
+          for (size_t vertex_id = 0; vertex_id < graph.vertices_.size();
+               vertex_id++) {
+            const auto new_vertex_id = vertex_offset + vertex_id;
+            merged_graph.vertices_[new_vertex_id] = Vertex(new_vertex_id);
+            merged_graph.vertex_depths_list_[new_vertex_id] =
+                graph.vertex_depths_list_[vertex_id];
+            // Stays within the reserved capacity, so it does not allocate.
+            auto& edge_ids = merged_graph.adjacency_list_[new_vertex_id];
+            for (const auto edge_id : graph.adjacency_list_[vertex_id]) {
+              edge_ids.push_back(EdgeTable::shift_edge_id(
+                  edge_id, vertex_offset, explicit_edge_offset));
+            }
+          }
+
+          if (!graph.indices_.depth_buckets) {
+            continue;
+          }
+          for (Depth depth = 0; depth <= graph.get_depth(); depth++) {
+            const auto& depth_vertices = graph.depth_vertices_list_[depth];
+            const auto depth_vertex_offset = depth_vertex_offsets[i][depth];
+            for (size_t position = 0; position < depth_vertices.size();
+                 position++) {
+              const auto new_vertex_id =
+                  depth_vertices[position] + vertex_offset;
+              const auto new_position = depth_vertex_offset + position;
+              merged_graph.depth_vertices_list_[depth][new_position] =
+                  new_vertex_id;
+              merged_graph.vertex_depth_positions_[new_vertex_id] =
+                  new_position;
+            }
+          }
+        }
+      });
+
+  if (indices.neighbor_sets) {
+    merged_graph.neighbor_sets_.resize(vertices_count);
+    for (size_t i = 0; i < graphs_count; i++) {
+      const auto vertex_offset = vertex_offsets[i];
+      for (const auto& edge : graphs[i]->edges_) {
+        const auto from_vertex_id = edge.from_vertex_id() + vertex_offset;
+        const auto to_vertex_id = edge.to_vertex_id() + vertex_offset;
+        merged_graph.neighbor_sets_[from_vertex_id].insert(to_vertex_id);
+        merged_graph.neighbor_sets_[to_vertex_id].insert(from_vertex_id);
+      }
+    }
+  }
+
+  const auto memory_resource = merged_graph.get_memory_resource();
+  for (size_t i = 0; i < graphs_count; i++) {
+    const auto& graph = *graphs[i];
+    const auto vertex_offset = vertex_offsets[i];
+    const auto explicit_edge_offset = explicit_edge_offsets[i];
+    const auto graph_vertices_count = graph.vertices_.size();
+    const auto graph_explicit_edges_count =
+        graph.edges_.get_explicit_edges_count();
+
+    const auto new_vertex_id = [vertex_offset,
+                                graph_vertices_count](size_t vertex_id) {
+      return (vertex_id < graph_vertices_count)
+                 ? vertex_offset + vertex_id
+                 : PropertyMap<int64_t>::kDroppedId;
+    };
+    const auto for_each_vertex_id = [graph_vertices_count](
+                                        const auto& function) {
+      for (size_t vertex_id = 0; vertex_id < graph_vertices_count;
+           vertex_id++) {
+        function(vertex_id);
+      }
+    };
+    for (const auto& property : graph.vertex_properties_) {
+      std::visit(
+          [&merged_graph, &property, memory_resource, &new_vertex_id,
+           &for_each_vertex_id](const auto& property_map) {
+            merge_property(merged_graph.vertex_properties_, property.first,
+                           property_map, memory_resource, new_vertex_id,
+                           for_each_vertex_id);
+          },
+          property.second);
+    }
+
+    const auto new_edge_id = [vertex_offset, explicit_edge_offset,
+                              graph_vertices_count,
+                              graph_explicit_edges_count](size_t edge_id) {
+      const auto edge_index = edge_id / 2;
+      const auto edges_count = EdgeTable::is_grey_edge_id(edge_id)
+                                   ? graph_vertices_count
+                                   : graph_explicit_edges_count;
+      return (edge_index < edges_count)
+                 ? EdgeTable::shift_edge_id(edge_id, vertex_offset,
+                                            explicit_edge_offset)
+                 : PropertyMap<int64_t>::kDroppedId;
+    };
+    const auto for_each_edge_id = [&graph](const auto& function) {
+      for (const auto& edge : graph.edges_) {
+        function(edge.id());
+      }
+    };
+    for (const auto& property : graph.edge_properties_) {
+      std::visit(
+          [&merged_graph, &property, memory_resource, &new_edge_id,
+           &for_each_edge_id](const auto& property_map) {
+            merge_property(merged_graph.edge_properties_, property.first,
+                           property_map, memory_resource, new_edge_id,
+                           for_each_edge_id);
+          },
+          property.second);
+    }
+  }
+
+  return merged_graph;
+}
+
+void Graph::compact() {
+  if (!has_removed_entries()) {
+    return;
+  }
+
+  const auto vertices_count = vertices_.size();
+  auto new_vertex_ids = std::vector<VertexId>();
+  const auto new_vertices_count = number_kept_items(
+      vertices_count,
+      [this](size_t vertex_id) { return !is_vertex_removed(vertex_id); },
+      EdgeTable::kRemovedVertexId, new_vertex_ids);
+  const auto new_edge_ids = edges_.compact(new_vertex_ids, new_vertices_count);
+
+  // Threads only filter and renumber the adjacency lists in place, as the
+  // graph memory resource need not be thread safe. Moving the lists to their
+  // new positions afterwards does not allocate either.
+  parallel_for(vertices_count, kMinItemsPerThread,
+               [this, &new_vertex_ids, &new_edge_ids](size_t, size_t begin,
+                                                      size_t end) {
+                 for (auto vertex_id = begin; vertex_id < end; vertex_id++) {
+                   if (new_vertex_ids[vertex_id] ==
+                       EdgeTable::kRemovedVertexId) {
+                     continue;
+                   }
+                   auto& edge_ids = adjacency_list_[vertex_id];
+                   size_t kept_count = 0;
+                   for (const auto edge_id : edge_ids) {
+                     const auto new_edge_id = new_edge_ids[edge_id];
+                     if (new_edge_id != EdgeTable::kRemovedEdgeId) {
+                       edge_ids[kept_count++] = new_edge_id;
+                     }
+                   }
+                   edge_ids.erase(edge_ids.begin() + kept_count,
+                                  edge_ids.end());
+                 }
+               });
+
+  const auto memory_resource = get_memory_resource();
+  const auto edges_memory_resource = get_edges_memory_resource();
+  auto adjacency_list = std::pmr::vector<std::pmr::vector<EdgeId>>(
+      new_vertices_count, edges_memory_resource);
+  auto vertex_depths_list =
+      std::pmr::vector<Depth>(new_vertices_count, memory_resource);
+  for (auto& depth_vertices : depth_vertices_list_) {
+    depth_vertices.clear();
+  }
+  vertex_depth_positions_.resize(indices_.depth_buckets ? new_vertices_count
+                                                        : 0);
+
+  for (size_t vertex_id = 0; vertex_id < vertices_count; vertex_id++) {
+    const auto new_vertex_id = new_vertex_ids[vertex_id];
+    if (new_vertex_id == EdgeTable::kRemovedVertexId) {
+      continue;
+    }
+
+    adjacency_list[new_vertex_id] = std::move(adjacency_list_[vertex_id]);
+    const auto depth = get_vertex_depth(vertex_id);
+    vertex_depths_list[new_vertex_id] = depth;
+    if (indices_.depth_buckets) {
+      vertex_depth_positions_[new_vertex_id] =
+          depth_vertices_list_[depth].size();
+      depth_vertices_list_[depth].push_back(new_vertex_id);
+    }
+  }
+
+  auto neighbor_sets = std::pmr::vector<NeighborSet<VertexId>>(
+      indices_.neighbor_sets ? new_vertices_count : 0, edges_memory_resource);
+  if (indices_.neighbor_sets) {
+    for (const auto& edge : edges_) {
+      neighbor_sets[edge.from_vertex_id()].insert(edge.to_vertex_id());
+      neighbor_sets[edge.to_vertex_id()].insert(edge.from_vertex_id());
+    }
+  }
+
+  adjacency_list_ = std::move(adjacency_list);
+  neighbor_sets_ = std::move(neighbor_sets);
+  vertex_depths_list_ = std::move(vertex_depths_list);
+  vertices_.erase(vertices_.begin() + new_vertices_count, vertices_.end());
+  next_free_vertex_id_ = new_vertices_count;
+  removed_vertices_.clear();
+  removed_vertices_count_ = 0;
+
+  // Depths left without vertices have no edges counted at them either.
+  while (depth_vertices_list_.size() > 1 &&
+         depth_vertices_counts_.back() == 0) {
+    depth_vertices_list_.pop_back();
+    depth_vertices_counts_.pop_back();
+    depth_color_edges_counts_.pop_back();
+  }
+
+  for (auto& [name, property] : vertex_properties_) {
+    std::visit(
+        [&new_vertex_ids](auto& property_map) {
+          property_map.relabel([&new_vertex_ids](size_t id) {
+            return id < new_vertex_ids.size() &&
+                           new_vertex_ids[id] != EdgeTable::kRemovedVertexId
+                       ? new_vertex_ids[id]
+                       : PropertyMap<int64_t>::kDroppedId;
+          });
+        },
+        property);
+  }
+  for (auto& [name, property] : edge_properties_) {
+    std::visit(
+        [&new_edge_ids](auto& property_map) {
+          property_map.relabel([&new_edge_ids](size_t id) {
+            return id < new_edge_ids.size() &&
+                           new_edge_ids[id] != EdgeTable::kRemovedEdgeId
+                       ? new_edge_ids[id]
+                       : PropertyMap<int64_t>::kDroppedId;
+          });
+        },
+        property);
+  }
+}
+
 Graph::Depth Graph::get_depth() const {
   return (depth_vertices_list_.empty()) ? (0)
                                         : (depth_vertices_list_.size() - 1);
 }
 
-const std::vector<Graph::VertexId>& Graph::get_depth_vertex_ids(
+Span<const Graph::VertexId> Graph::get_depth_vertex_ids(
     Graph::Depth depth) const {
+  if (!indices_.depth_buckets) {
+    throw std::logic_error("Depth buckets index is disabled");
+  }
   if (depth > get_depth()) {
-    static const std::vector<VertexId> empty_result;
-    return empty_result;
+    return {};
   }
 
   return depth_vertices_list_.at(depth);
 }
 
-const std::vector<Graph::EdgeId>& Graph::get_connected_edge_ids(
+Graph::ConnectedEdgeIds Graph::get_connected_edge_ids(
     Graph::VertexId vertex_id) const {
-  if (adjacency_list_.find(vertex_id) == adjacency_list_.end()) {
-    static const std::vector<Graph::EdgeId> empty_result;
-    return empty_result;
+  if (vertex_id >= next_free_vertex_id_) {
+    return {};
   }
 
-  return adjacency_list_.at(vertex_id);
+  const auto grey_edge_id =
+      edges_.has_grey_edge(vertex_id)
+          ? std::optional(EdgeTable::grey_edge_id(vertex_id))
+          : std::nullopt;
+  return ConnectedEdgeIds(grey_edge_id, adjacency_list_[vertex_id]);
 }
 
 bool Graph::is_vertices_connected(Graph::VertexId first_vertex_id,
                                   Graph::VertexId second_vertex_id) const {
-  const auto& connected_edge_ids = get_connected_edge_ids(first_vertex_id);
-
-  for (const auto& edge_id : connected_edge_ids) {
-    const auto& current_edge = edges_.at(edge_id);
-    if ((first_vertex_id == current_edge.from_vertex_id() &&
-         second_vertex_id == current_edge.to_vertex_id()) ||
-        (first_vertex_id == current_edge.to_vertex_id() &&
-         second_vertex_id == current_edge.from_vertex_id())) {
-      return true;
-    }
+  if (first_vertex_id >= next_free_vertex_id_) {
+    return false;
   }
 
-  return false;
+  if (!indices_.neighbor_sets) {
+    return is_vertices_connected_by_scan(first_vertex_id, second_vertex_id);
+  }
+  return neighbor_sets_[first_vertex_id].contains(second_vertex_id);
 }
 
 Graph::Depth Graph::get_vertex_depth(Graph::VertexId vertex_id) const {
   return vertex_depths_list_.at(vertex_id);
 }
 
-const std::unordered_map<Graph::VertexId, Graph::Vertex>& Graph::get_vertices()
-    const {
+const std::pmr::vector<Graph::Vertex>& Graph::get_vertices() const {
   return vertices_;
 }
 
-const std::unordered_map<Graph::EdgeId, Graph::Edge>& Graph::get_edges() const {
+const Graph::EdgeTable& Graph::get_edges() const {
   return edges_;
 }
 
-Graph::VertexId Graph::get_new_vertex_id() {
-  return next_free_vertex_id_++;
+Graph::Edge Graph::EdgeTable::Iterator::operator*() const {
+  const auto vertices_count = edge_table_->parent_vertex_ids_.size();
+  const auto edge_id =
+      (position_ < vertices_count)
+          ? grey_edge_id(position_)
+          : explicit_edge_id(position_ - vertices_count);
+  return (*edge_table_)[edge_id];
+}
+
+void Graph::EdgeTable::Iterator::skip_missing_edges() {
+  const auto vertices_count = edge_table_->parent_vertex_ids_.size();
+  const auto end_position =
+      vertices_count + edge_table_->from_vertex_ids_.size();
+  while (position_ < end_position) {
+    const auto edge_id = (position_ < vertices_count)
+                             ? grey_edge_id(position_)
+                             : explicit_edge_id(position_ - vertices_count);
+    const auto is_stored = position_ >= vertices_count ||
+                           edge_table_->has_grey_edge(position_);
+    if (is_stored && !edge_table_->is_removed(edge_id)) {
+      return;
+    }
+    position_++;
+  }
+}
+
+Graph::EdgeId Graph::EdgeTable::add_edge(Graph::VertexId from_vertex_id,
+                                         Graph::VertexId to_vertex_id,
+                                         Graph::Edge::Color color) {
+  if (color == Edge::Color::Grey) {
+    assert(!has_grey_edge(to_vertex_id) && "Vertex already has a grey edge");
+    parent_vertex_ids_[to_vertex_id] = from_vertex_id;
+    color_edges_counts_[static_cast<int>(color)]++;
+    return grey_edge_id(to_vertex_id);
+  }
+
+  const auto edge_index = from_vertex_ids_.size();
+  if (edge_index == kMaxExplicitEdgesCount) {
+    throw std::overflow_error("Edge ids are exhausted");
+  }
+  if (edge_index % kColorsPerWord == 0) {
+    packed_colors_.push_back(0);
+  }
+  packed_colors_.back() |= static_cast<uint64_t>(color)
+                           << (edge_index % kColorsPerWord * kColorBits);
+
+  from_vertex_ids_.push_back(from_vertex_id);
+  to_vertex_ids_.push_back(to_vertex_id);
+  color_edges_counts_[static_cast<int>(color)]++;
+
+  return explicit_edge_id(edge_index);
+}
+
+bool Graph::EdgeTable::contains(Graph::EdgeId edge_id) const {
+  if (is_grey_edge_id(edge_id)) {
+    const auto vertex_id = grey_edge_vertex_id(edge_id);
+    if (vertex_id >= parent_vertex_ids_.size() || !has_grey_edge(vertex_id)) {
+      return false;
+    }
+  } else if (explicit_edge_index(edge_id) >= from_vertex_ids_.size()) {
+    return false;
+  }
+
+  return !is_removed(edge_id);
+}
+
+void Graph::EdgeTable::remove_edge(Graph::EdgeId edge_id) {
+  assert(contains(edge_id) && "Edge does not exist or is removed");
+
+  const auto is_grey = is_grey_edge_id(edge_id);
+  auto& removed_edges = is_grey ? removed_grey_edges_ : removed_explicit_edges_;
+  const auto index =
+      is_grey ? grey_edge_vertex_id(edge_id) : explicit_edge_index(edge_id);
+  if (index >= removed_edges.size()) {
+    removed_edges.resize(
+        is_grey ? parent_vertex_ids_.size() : from_vertex_ids_.size(), false);
+  }
+
+  removed_edges[index] = true;
+  color_edges_counts_[static_cast<int>(color(edge_id))]--;
+  removed_edges_count_++;
+}
+
+bool Graph::EdgeTable::is_removed(Graph::EdgeId edge_id) const {
+  if (is_grey_edge_id(edge_id)) {
+    const auto vertex_id = grey_edge_vertex_id(edge_id);
+    return vertex_id < removed_grey_edges_.size() &&
+           removed_grey_edges_[vertex_id];
+  }
+
+  const auto edge_index = explicit_edge_index(edge_id);
+  return edge_index < removed_explicit_edges_.size() &&
+         removed_explicit_edges_[edge_index];
+}
+
+std::vector<Graph::EdgeId> Graph::EdgeTable::compact(
+    const std::vector<Graph::VertexId>& new_vertex_ids,
+    size_t new_vertices_count) {
+  const auto vertices_count = parent_vertex_ids_.size();
+  const auto explicit_edges_count = from_vertex_ids_.size();
+  auto new_edge_ids = std::vector<EdgeId>(
+      2 * std::max(vertices_count, explicit_edges_count), kRemovedEdgeId);
+
+  // Removing a vertex removes the grey edges to its children, so a kept grey
+  // edge always has a kept parent.
+  auto parent_vertex_ids =
+      std::pmr::vector<VertexId>(new_vertices_count, kNoParentVertexId,
+                                 parent_vertex_ids_.get_allocator());
+  parallel_for(vertices_count, kMinItemsPerThread,
+               [this, &new_vertex_ids, &new_edge_ids, &parent_vertex_ids](
+                   size_t, size_t begin, size_t end) {
+                 for (auto vertex_id = begin; vertex_id < end; vertex_id++) {
+                   const auto new_vertex_id = new_vertex_ids[vertex_id];
+                   const auto edge_id = grey_edge_id(vertex_id);
+                   if (new_vertex_id == kRemovedVertexId ||
+                       !has_grey_edge(vertex_id) || is_removed(edge_id)) {
+                     continue;
+                   }
+                   parent_vertex_ids[new_vertex_id] =
+                       new_vertex_ids[parent_vertex_ids_[vertex_id]];
+                   new_edge_ids[edge_id] = grey_edge_id(new_vertex_id);
+                 }
+               });
+
+  auto new_edge_indices = std::vector<size_t>();
+  const auto new_explicit_edges_count = number_kept_items(
+      explicit_edges_count,
+      [this](size_t edge_index) {
+        return !is_removed(explicit_edge_id(edge_index));
+      },
+      std::numeric_limits<size_t>::max(), new_edge_indices);
+
+  const auto allocator = from_vertex_ids_.get_allocator();
+  auto from_vertex_ids =
+      std::pmr::vector<VertexId>(new_explicit_edges_count, allocator);
+  auto to_vertex_ids =
+      std::pmr::vector<VertexId>(new_explicit_edges_count, allocator);
+  auto colors = std::vector<uint8_t>(new_explicit_edges_count);
+  parallel_for(explicit_edges_count, kMinItemsPerThread,
+               [this, &new_vertex_ids, &new_edge_ids, &new_edge_indices,
+                &from_vertex_ids, &to_vertex_ids,
+                &colors](size_t, size_t begin, size_t end) {
+                 for (auto edge_index = begin; edge_index < end;
+                      edge_index++) {
+                   const auto edge_id = explicit_edge_id(edge_index);
+                   if (is_removed(edge_id)) {
+                     continue;
+                   }
+                   const auto new_edge_index = new_edge_indices[edge_index];
+                   from_vertex_ids[new_edge_index] =
+                       new_vertex_ids[from_vertex_ids_[edge_index]];
+                   to_vertex_ids[new_edge_index] =
+                       new_vertex_ids[to_vertex_ids_[edge_index]];
+                   colors[new_edge_index] =
+                       static_cast<uint8_t>(color(edge_id));
+                   new_edge_ids[edge_id] = explicit_edge_id(new_edge_index);
+                 }
+               });
+
+  parent_vertex_ids_ = std::move(parent_vertex_ids);
+  from_vertex_ids_ = std::move(from_vertex_ids);
+  to_vertex_ids_ = std::move(to_vertex_ids);
+  pack_colors(colors);
+  removed_grey_edges_.clear();
+  removed_explicit_edges_.clear();
+  removed_edges_count_ = 0;
+
+  return new_edge_ids;
+}
+
+void Graph::EdgeTable::merge(const std::vector<const EdgeTable*>& edge_tables,
+                             const std::vector<size_t>& vertex_offsets,
+                             const std::vector<size_t>& explicit_edge_offsets) {
+  const auto tables_count = edge_tables.size();
+  const auto vertices_count = vertex_offsets.back();
+  const auto explicit_edges_count = explicit_edge_offsets.back();
+
+  parent_vertex_ids_.assign(vertices_count, kNoParentVertexId);
+  from_vertex_ids_.resize(explicit_edges_count);
+  to_vertex_ids_.resize(explicit_edges_count);
+  auto colors = std::vector<uint8_t>(explicit_edges_count);
+  parallel_for(
+      tables_count,
+      get_min_graphs_per_range(tables_count,
+                               vertices_count + explicit_edges_count),
+      [this, &edge_tables, &vertex_offsets, &explicit_edge_offsets, &colors](
+          size_t, size_t begin, size_t end) {
+        for (auto table = begin; table < end; table++) {
+          const auto& edge_table = *edge_tables[table];
+          const auto vertex_offset = vertex_offsets[table];
+          const auto explicit_edge_offset = explicit_edge_offsets[table];
+          const auto& parent_vertex_ids = edge_table.parent_vertex_ids_;
+          for (size_t vertex_id = 0; vertex_id < parent_vertex_ids.size();
+               vertex_id++) {
+            if (parent_vertex_ids[vertex_id] != kNoParentVertexId) {
+              parent_vertex_ids_[vertex_offset + vertex_id] =
+                  parent_vertex_ids[vertex_id] + vertex_offset;
+            }
+          }
+          for (size_t edge_index = 0;
+               edge_index < edge_table.get_explicit_edges_count();
+               edge_index++) {
+            const auto new_edge_index = explicit_edge_offset + edge_index;
+            from_vertex_ids_[new_edge_index] =
+                edge_table.from_vertex_ids_[edge_index] + vertex_offset;
+            to_vertex_ids_[new_edge_index] =
+                edge_table.to_vertex_ids_[edge_index] + vertex_offset;
+            colors[new_edge_index] = static_cast<uint8_t>(
+                edge_table.color(explicit_edge_id(edge_index)));
+          }
+        }
+      });
+  pack_colors(colors);
+
+  color_edges_counts_ = {};
+  for (const auto* edge_table : edge_tables) {
+    for (int color = 0; color < Edge::kColorsCount; color++) {
+      color_edges_counts_[color] += edge_table->color_edges_counts_[color];
+    }
+  }
+  removed_grey_edges_.clear();
+  removed_explicit_edges_.clear();
+  removed_edges_count_ = 0;
+}
+
+void Graph::EdgeTable::pack_colors(const std::vector<uint8_t>& colors) {
+  const auto colors_count = colors.size();
+  const auto words_count = (colors_count + kColorsPerWord - 1) / kColorsPerWord;
+  packed_colors_.assign(words_count, 0);
+  // Colors are packed word by word, so no two threads write one word.
+  parallel_for(words_count, kMinItemsPerThread / kColorsPerWord,
+               [this, &colors, colors_count](size_t, size_t begin,
+                                             size_t end) {
+                 for (auto word = begin; word < end; word++) {
+                   const auto words_end =
+                       std::min((word + 1) * kColorsPerWord, colors_count);
+                   for (auto index = word * kColorsPerWord; index < words_end;
+                        index++) {
+                     packed_colors_[word] |=
+                         static_cast<uint64_t>(colors[index])
+                         << (index % kColorsPerWord * kColorBits);
+                   }
+                 }
+               });
+}
+
+void Graph::EdgeTable::reserve(size_t vertices_count,
+                               size_t explicit_edges_count) {
+  parent_vertex_ids_.reserve(vertices_count);
+  from_vertex_ids_.reserve(explicit_edges_count);
+  to_vertex_ids_.reserve(explicit_edges_count);
+  packed_colors_.reserve((explicit_edges_count + kColorsPerWord - 1) /
+                         kColorsPerWord);
+}
+
+void Graph::EdgeTable::relabel_vertices(
+    const std::vector<Graph::VertexId>& new_vertex_ids) {
+  auto parent_vertex_ids =
+      std::pmr::vector<VertexId>(parent_vertex_ids_.size(), kNoParentVertexId,
+                                 parent_vertex_ids_.get_allocator());
+  for (size_t i = 0; i < parent_vertex_ids_.size(); i++) {
+    if (parent_vertex_ids_[i] != kNoParentVertexId) {
+      parent_vertex_ids[new_vertex_ids[i]] =
+          new_vertex_ids[parent_vertex_ids_[i]];
+    }
+  }
+  parent_vertex_ids_ = std::move(parent_vertex_ids);
+
+  for (auto& vertex_id : from_vertex_ids_) {
+    vertex_id = new_vertex_ids[vertex_id];
+  }
+  for (auto& vertex_id : to_vertex_ids_) {
+    vertex_id = new_vertex_ids[vertex_id];
+  }
+}
+
+Graph::Edge Graph::EdgeTable::operator[](Graph::EdgeId edge_id) const {
+  return Edge(edge_id, from_vertex_id(edge_id), to_vertex_id(edge_id),
+              color(edge_id));
+}
+
+Graph::VertexId Graph::EdgeTable::from_vertex_id(Graph::EdgeId edge_id) const {
+  if (is_grey_edge_id(edge_id)) {
+    return parent_vertex_ids_[grey_edge_vertex_id(edge_id)];
+  }
+  return from_vertex_ids_[explicit_edge_index(edge_id)];
+}
+
+Graph::VertexId Graph::EdgeTable::to_vertex_id(Graph::EdgeId edge_id) const {
+  if (is_grey_edge_id(edge_id)) {
+    return grey_edge_vertex_id(edge_id);
+  }
+  return to_vertex_ids_[explicit_edge_index(edge_id)];
+}
+
+Graph::Edge::Color Graph::EdgeTable::color(Graph::EdgeId edge_id) const {
+  if (is_grey_edge_id(edge_id)) {
+    return Edge::Color::Grey;
+  }
+
+  const auto edge_index = explicit_edge_index(edge_id);
+  const auto word = packed_colors_[edge_index / kColorsPerWord];
+  return static_cast<Edge::Color>(
+      (word >> (edge_index % kColorsPerWord * kColorBits)) & kColorMask);
 }
 
-Graph::EdgeId Graph::get_new_edge_id() {
-  return next_free_edge_id_++;
+std::pmr::memory_resource* Graph::get_memory_resource() const {
+  return vertices_.get_allocator().resource();
+}
+
+size_t Graph::EdgeTable::memory_usage() const {
+  return get_capacity_bytes(parent_vertex_ids_) +
+         get_capacity_bytes(from_vertex_ids_) +
+         get_capacity_bytes(to_vertex_ids_) +
+         get_capacity_bytes(packed_colors_) +
+         get_tombstones_bytes(removed_grey_edges_) +
+         get_tombstones_bytes(removed_explicit_edges_);
+}
+
+Graph::MemoryUsage Graph::memory_usage() const {
+  auto memory_usage = MemoryUsage();
+  memory_usage.vertices = get_capacity_bytes(vertices_) +
+                          get_tombstones_bytes(removed_vertices_);
+  memory_usage.edges = edges_.memory_usage();
+  memory_usage.adjacency = get_nested_capacity_bytes(adjacency_list_);
+
+  memory_usage.neighbor_sets = get_capacity_bytes(neighbor_sets_);
+  for (const auto& neighbor_set : neighbor_sets_) {
+    memory_usage.neighbor_sets += neighbor_set.allocated_bytes();
+  }
+
+  memory_usage.depths = get_capacity_bytes(vertex_depths_list_) +
+                        get_nested_capacity_bytes(depth_vertices_list_) +
+                        get_capacity_bytes(vertex_depth_positions_);
+  memory_usage.counters = get_capacity_bytes(depth_vertices_capacities_) +
+                          get_capacity_bytes(depth_vertices_counts_) +
+                          get_capacity_bytes(depth_color_edges_counts_);
+  for (const auto* properties : {&vertex_properties_, &edge_properties_}) {
+    for (const auto& [name, property] : *properties) {
+      memory_usage.properties += std::visit(
+          [](const auto& property_map) { return property_map.memory_usage(); },
+          property);
+    }
+  }
+  return memory_usage;
+}
+
+const PropertyMaps& Graph::get_vertex_properties() const {
+  return vertex_properties_;
+}
+
+const PropertyMaps& Graph::get_edge_properties() const {
+  return edge_properties_;
+}
+
+FrozenGraph Graph::freeze() const {
+  return FrozenGraph(*this);
+}
+
+std::vector<Graph::VertexId> Graph::get_depth_order() const {
+  const auto depth = get_depth();
+
+  auto parentless_vertex_ids = std::vector<std::vector<VertexId>>(depth + 1);
+  for (const auto& vertex : vertices_) {
+    if (!edges_.has_grey_edge(vertex.id())) {
+      parentless_vertex_ids[get_vertex_depth(vertex.id())].push_back(
+          vertex.id());
+    }
+  }
+
+  auto depth_order = std::vector<VertexId>();
+  depth_order.reserve(vertices_.size());
+
+  size_t previous_level_begin = 0;
+  for (Depth current_depth = 0; current_depth <= depth; current_depth++) {
+    const auto level_begin = depth_order.size();
+    for (auto i = previous_level_begin; i < level_begin; i++) {
+      for (const auto edge_id : adjacency_list_[depth_order[i]]) {
+        if (EdgeTable::is_grey_edge_id(edge_id)) {
+          depth_order.push_back(edges_.to_vertex_id(edge_id));
+        }
+      }
+    }
+    depth_order.insert(depth_order.end(),
+                       parentless_vertex_ids[current_depth].begin(),
+                       parentless_vertex_ids[current_depth].end());
+    previous_level_begin = level_begin;
+  }
+
+  return depth_order;
+}
+
+void Graph::relabel_vertices_by_depth() {
+  if (has_removed_entries()) {
+    throw std::logic_error("Graph has pending removals, compact it first");
+  }
+
+  const auto depth_order = get_depth_order();
+  const auto vertices_count = depth_order.size();
+
+  auto new_vertex_ids = std::vector<VertexId>(vertices_count);
+  for (size_t i = 0; i < vertices_count; i++) {
+    new_vertex_ids[depth_order[i]] = i;
+  }
+
+  edges_.relabel_vertices(new_vertex_ids);
+
+  const auto memory_resource = get_memory_resource();
+  const auto edges_memory_resource = get_edges_memory_resource();
+  auto adjacency_list = std::pmr::vector<std::pmr::vector<EdgeId>>(
+      vertices_count, edges_memory_resource);
+  auto neighbor_sets = std::pmr::vector<NeighborSet<VertexId>>(
+      indices_.neighbor_sets ? vertices_count : 0, edges_memory_resource);
+  auto vertex_depths_list =
+      std::pmr::vector<Depth>(vertices_count, memory_resource);
+  for (auto& depth_vertices : depth_vertices_list_) {
+    depth_vertices.clear();
+  }
+
+  for (size_t i = 0; i < vertices_count; i++) {
+    const auto old_vertex_id = depth_order[i];
+    adjacency_list[i] = std::move(adjacency_list_[old_vertex_id]);
+    for (auto& edge_id : adjacency_list[i]) {
+      edge_id = EdgeTable::relabel_edge_id(edge_id, new_vertex_ids);
+    }
+
+    const auto depth = get_vertex_depth(old_vertex_id);
+    vertex_depths_list[i] = depth;
+    if (indices_.depth_buckets) {
+      vertex_depth_positions_[i] = depth_vertices_list_[depth].size();
+      depth_vertices_list_[depth].push_back(i);
+    }
+  }
+
+  if (indices_.neighbor_sets) {
+    for (const auto& edge : edges_) {
+      neighbor_sets[edge.from_vertex_id()].insert(edge.to_vertex_id());
+      neighbor_sets[edge.to_vertex_id()].insert(edge.from_vertex_id());
+    }
+  }
+
+  adjacency_list_ = std::move(adjacency_list);
+  neighbor_sets_ = std::move(neighbor_sets);
+  vertex_depths_list_ = std::move(vertex_depths_list);
+
+  for (auto& [name, property] : vertex_properties_) {
+    std::visit(
+        [&new_vertex_ids](auto& property_map) {
+          property_map.relabel(
+              [&new_vertex_ids](size_t id) { return new_vertex_ids[id]; });
+        },
+        property);
+  }
+  for (auto& [name, property] : edge_properties_) {
+    std::visit(
+        [&new_vertex_ids](auto& property_map) {
+          property_map.relabel([&new_vertex_ids](size_t id) {
+            return EdgeTable::relabel_edge_id(id, new_vertex_ids);
+          });
+        },
+        property);
+  }
+}
+
+Graph::VertexId Graph::get_new_vertex_id() {
+  if (next_free_vertex_id_ > EdgeTable::kMaxVertexId) {
+    throw std::overflow_error("Vertex ids are exhausted");
+  }
+  return next_free_vertex_id_++;
 }
 
 Graph::Edge::Color Graph::determine_edge_color(
@@ -121,20 +1204,51 @@ Graph::Edge::Color Graph::determine_edge_color(
 
 void Graph::set_vertex_depth(Graph::VertexId vertex_id, Graph::Depth depth) {
   while (get_depth() < depth) {
-    depth_vertices_list_.push_back({});
+    add_depth();
   }
 
-  if (vertex_depths_list_.find(vertex_id) != vertex_depths_list_.end()) {
-    const Depth previous_depth = get_vertex_depth(vertex_id);
-
-    auto& previous_depth_vertices_list = depth_vertices_list_[previous_depth];
-    previous_depth_vertices_list.erase(
-        std::remove(previous_depth_vertices_list.begin(),
-                    previous_depth_vertices_list.end(), vertex_id),
-        previous_depth_vertices_list.end());
+  const Depth previous_depth = get_vertex_depth(vertex_id);
+  vertex_depths_list_[vertex_id] = depth;
+  depth_vertices_counts_[previous_depth]--;
+  depth_vertices_counts_[depth]++;
+  if (!indices_.depth_buckets) {
+    return;
   }
 
+  auto& previous_depth_vertices_list = depth_vertices_list_[previous_depth];
+  const auto last_vertex_id = previous_depth_vertices_list.back();
+  const auto vertex_position = vertex_depth_positions_[vertex_id];
+  previous_depth_vertices_list[vertex_position] = last_vertex_id;
+  vertex_depth_positions_[last_vertex_id] = vertex_position;
+  previous_depth_vertices_list.pop_back();
+
+  vertex_depth_positions_[vertex_id] = depth_vertices_list_[depth].size();
   depth_vertices_list_[depth].push_back(vertex_id);
-  vertex_depths_list_[vertex_id] = depth;
+}
+
+bool Graph::is_vertices_connected_by_scan(
+    Graph::VertexId first_vertex_id,
+    Graph::VertexId second_vertex_id) const {
+  for (const auto edge_id : get_connected_edge_ids(first_vertex_id)) {
+    const auto from_vertex_id = edges_.from_vertex_id(edge_id);
+    const auto to_vertex_id = edges_.to_vertex_id(edge_id);
+    if ((from_vertex_id == first_vertex_id &&
+         to_vertex_id == second_vertex_id) ||
+        (from_vertex_id == second_vertex_id &&
+         to_vertex_id == first_vertex_id)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Graph::add_depth() {
+  const Depth depth = depth_vertices_list_.size();
+  auto& depth_vertices = depth_vertices_list_.emplace_back();
+  depth_vertices_counts_.push_back(0);
+  depth_color_edges_counts_.emplace_back();
+  if (static_cast<size_t>(depth) < depth_vertices_capacities_.size()) {
+    depth_vertices.reserve(depth_vertices_capacities_[depth]);
+  }
 }
 }  // namespace uni_course_cpp
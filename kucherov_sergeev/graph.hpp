@@ -1,18 +1,39 @@
 #pragma once
 
-#include <unordered_map>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
 #include <vector>
 
+#include "neighbor_set.hpp"
+#include "property_map.hpp"
+#include "span.hpp"
+
 namespace uni_course_cpp {
+class FrozenGraph;
+
 class Graph {
  public:
-  using VertexId = int;
-  using EdgeId = int;
+  // Ids are 32 bit, halving index memory, unless the build defines
+  // UNI_COURSE_CPP_64_BIT_IDS for graphs that outgrow them.
+#ifdef UNI_COURSE_CPP_64_BIT_IDS
+  using VertexId = uint64_t;
+  using EdgeId = uint64_t;
+#else
+  using VertexId = uint32_t;
+  using EdgeId = uint32_t;
+#endif
   using Depth = int;
 
   struct Edge {
    public:
     enum class Color { Grey, Green, Yellow, Red };
+    static constexpr int kColorsCount = 4;
 
     Edge(EdgeId id, VertexId from_vertex_id, VertexId to_vertex_id, Color color)
         : id_(id),
@@ -41,43 +62,490 @@ class Graph {
     VertexId id_ = 0;
   };
 
+  // Edge storage split by color. Every vertex gets at most one grey edge, the
+  // one that attached it to the tree, so grey edges are kept implicitly as a
+  // parent array indexed by their target vertex. The remaining edges live in
+  // columns: endpoints in separate arrays and colors packed two bits per
+  // edge, 32 edges per word.
+  //
+  // Edge ids encode where an edge is stored and stay stable while the graph
+  // grows: the grey edge of vertex v has id 2 * v and the k-th other edge
+  // has id 2 * k + 1.
+  class EdgeTable {
+   public:
+    class Iterator {
+     public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = Edge;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = Edge;
+
+      // Positions below the vertices count walk the grey edges, the rest
+      // walk the explicitly stored ones. Removed edges are skipped.
+      Iterator(const EdgeTable& edge_table, size_t position)
+          : edge_table_(&edge_table), position_(position) {
+        skip_missing_edges();
+      }
+
+      Edge operator*() const;
+      Iterator& operator++() {
+        position_++;
+        skip_missing_edges();
+        return *this;
+      }
+      bool operator==(const Iterator& other) const {
+        return position_ == other.position_;
+      }
+      bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+     private:
+      void skip_missing_edges();
+
+      const EdgeTable* edge_table_ = nullptr;
+      size_t position_ = 0;
+    };
+
+    static constexpr VertexId kNoParentVertexId =
+        std::numeric_limits<VertexId>::max();
+    // Largest ids whose encoded edge ids still fit into EdgeId.
+    static constexpr VertexId kMaxVertexId =
+        std::numeric_limits<EdgeId>::max() / 2;
+    static constexpr size_t kMaxExplicitEdgesCount =
+        std::numeric_limits<EdgeId>::max() / 2;
+    // Never valid ids, as they are above the largest ones.
+    static constexpr VertexId kRemovedVertexId =
+        std::numeric_limits<VertexId>::max();
+    static constexpr EdgeId kRemovedEdgeId = std::numeric_limits<EdgeId>::max();
+
+    EdgeTable() = default;
+    explicit EdgeTable(std::pmr::memory_resource* memory_resource)
+        : parent_vertex_ids_(memory_resource),
+          from_vertex_ids_(memory_resource),
+          to_vertex_ids_(memory_resource),
+          packed_colors_(memory_resource),
+          removed_grey_edges_(memory_resource),
+          removed_explicit_edges_(memory_resource) {}
+
+    static EdgeId grey_edge_id(VertexId vertex_id) { return 2 * vertex_id; }
+    static bool is_grey_edge_id(EdgeId edge_id) { return edge_id % 2 == 0; }
+
+    // Maps an edge id onto renumbered vertices: grey edge ids follow their
+    // target vertex, the other ids do not depend on vertex ids.
+    static EdgeId relabel_edge_id(EdgeId edge_id,
+                                  const std::vector<VertexId>& new_vertex_ids) {
+      return is_grey_edge_id(edge_id)
+                 ? grey_edge_id(new_vertex_ids[grey_edge_vertex_id(edge_id)])
+                 : edge_id;
+    }
+
+    void add_vertex() { parent_vertex_ids_.push_back(kNoParentVertexId); }
+
+    void reserve(size_t vertices_count, size_t explicit_edges_count);
+
+    void relabel_vertices(const std::vector<VertexId>& new_vertex_ids);
+
+    // Drops removed edges and edges of removed vertices, which new_vertex_ids
+    // maps to kRemovedVertexId, and renumbers the rest densely in order.
+    // Returns the new id of every old edge id, kRemovedEdgeId for dropped
+    // ones.
+    std::vector<EdgeId> compact(const std::vector<VertexId>& new_vertex_ids,
+                                size_t new_vertices_count);
+
+    // Replaces the edges with those of the tables, shifting the vertex ids
+    // and explicit edge indices of the i-th table by the i-th offsets. Both
+    // offset lists end with the totals.
+    void merge(const std::vector<const EdgeTable*>& edge_tables,
+               const std::vector<size_t>& vertex_offsets,
+               const std::vector<size_t>& explicit_edge_offsets);
+
+    // Maps an edge id of a table onto the merged one, see merge().
+    static EdgeId shift_edge_id(EdgeId edge_id,
+                                size_t vertex_offset,
+                                size_t explicit_edge_offset) {
+      return edge_id + 2 * (is_grey_edge_id(edge_id) ? vertex_offset
+                                                     : explicit_edge_offset);
+    }
+
+    size_t get_explicit_edges_count() const { return from_vertex_ids_.size(); }
+
+    EdgeId add_edge(VertexId from_vertex_id,
+                    VertexId to_vertex_id,
+                    Edge::Color color);
+
+    Edge operator[](EdgeId edge_id) const;
+
+    VertexId from_vertex_id(EdgeId edge_id) const;
+    VertexId to_vertex_id(EdgeId edge_id) const;
+    Edge::Color color(EdgeId edge_id) const;
+
+    bool has_grey_edge(VertexId vertex_id) const {
+      return parent_vertex_ids_[vertex_id] != kNoParentVertexId;
+    }
+
+    // Whether the edge was added and not removed.
+    bool contains(EdgeId edge_id) const;
+
+    // Marks the edge with a tombstone, compact() drops it.
+    void remove_edge(EdgeId edge_id);
+    bool is_removed(EdgeId edge_id) const;
+    bool has_removed_edges() const { return removed_edges_count_ != 0; }
+
+    // Edges that are not removed.
+    size_t size() const {
+      size_t edges_count = 0;
+      for (const auto color_edges_count : color_edges_counts_) {
+        edges_count += color_edges_count;
+      }
+      return edges_count;
+    }
+    bool empty() const { return size() == 0; }
+
+    Iterator begin() const { return Iterator(*this, 0); }
+    Iterator end() const {
+      return Iterator(*this,
+                      parent_vertex_ids_.size() + from_vertex_ids_.size());
+    }
+
+    // Bytes reserved by the edge columns.
+    size_t memory_usage() const;
+
+    std::pmr::memory_resource* get_memory_resource() const {
+      return parent_vertex_ids_.get_allocator().resource();
+    }
+
+    size_t count_color(Edge::Color color) const {
+      return color_edges_counts_[static_cast<int>(color)];
+    }
+
+   private:
+    static constexpr int kColorBits = 2;
+    static constexpr int kColorsPerWord = 64 / kColorBits;
+    static constexpr uint64_t kColorMask = (1ull << kColorBits) - 1;
+
+    static VertexId grey_edge_vertex_id(EdgeId edge_id) { return edge_id / 2; }
+    static EdgeId explicit_edge_id(size_t index) { return 2 * index + 1; }
+    static size_t explicit_edge_index(EdgeId edge_id) { return edge_id / 2; }
+
+    // Replaces the packed colors with the given ones, one per byte.
+    void pack_colors(const std::vector<uint8_t>& colors);
+
+    std::pmr::vector<VertexId> parent_vertex_ids_;
+    std::array<size_t, Edge::kColorsCount> color_edges_counts_ = {};
+    std::pmr::vector<VertexId> from_vertex_ids_;
+    std::pmr::vector<VertexId> to_vertex_ids_;
+    std::pmr::vector<uint64_t> packed_colors_;
+    // Tombstones, indexed like parent_vertex_ids_ and from_vertex_ids_ and
+    // allocated by the first removal. Ids past their end are not removed.
+    std::pmr::vector<bool> removed_grey_edges_;
+    std::pmr::vector<bool> removed_explicit_edges_;
+    size_t removed_edges_count_ = 0;
+  };
+
+  // Connected edge ids of a vertex: its own grey edge, which is not stored in
+  // the adjacency list, followed by the stored ones.
+  class ConnectedEdgeIds {
+   public:
+    class Iterator {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = EdgeId;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const EdgeId*;
+      using reference = EdgeId;
+
+      Iterator(bool is_at_grey_edge, EdgeId grey_edge_id, const EdgeId* edge_id)
+          : is_at_grey_edge_(is_at_grey_edge),
+            grey_edge_id_(grey_edge_id),
+            edge_id_(edge_id) {}
+
+      EdgeId operator*() const {
+        return is_at_grey_edge_ ? grey_edge_id_ : *edge_id_;
+      }
+      Iterator& operator++() {
+        if (is_at_grey_edge_) {
+          is_at_grey_edge_ = false;
+        } else {
+          edge_id_++;
+        }
+        return *this;
+      }
+      bool operator==(const Iterator& other) const {
+        return is_at_grey_edge_ == other.is_at_grey_edge_ &&
+               edge_id_ == other.edge_id_;
+      }
+      bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+     private:
+      bool is_at_grey_edge_ = false;
+      EdgeId grey_edge_id_ = 0;
+      const EdgeId* edge_id_ = nullptr;
+    };
+
+    ConnectedEdgeIds() = default;
+    ConnectedEdgeIds(std::optional<EdgeId> grey_edge_id,
+                     Span<const EdgeId> edge_ids)
+        : has_grey_edge_(grey_edge_id.has_value()),
+          grey_edge_id_(grey_edge_id.value_or(0)),
+          edge_ids_(edge_ids) {}
+
+    Iterator begin() const {
+      return Iterator(has_grey_edge_, grey_edge_id_, edge_ids_.begin());
+    }
+    Iterator end() const { return Iterator(false, 0, edge_ids_.end()); }
+    size_t size() const { return edge_ids_.size() + (has_grey_edge_ ? 1 : 0); }
+    bool empty() const { return size() == 0; }
+
+   private:
+    bool has_grey_edge_ = false;
+    EdgeId grey_edge_id_ = 0;
+    Span<const EdgeId> edge_ids_;
+  };
+
+  // Bytes held by the containers of the graph, counted by capacity rather
+  // than by size, grouped by what they store.
+  struct MemoryUsage {
+    size_t vertices = 0;
+    // Edge columns, colors included.
+    size_t edges = 0;
+    size_t adjacency = 0;
+    // Includes estimates for the hash set nodes of high degree vertices.
+    size_t neighbor_sets = 0;
+    // Vertex depths, depth buckets and positions inside them.
+    size_t depths = 0;
+    // Summary counters and planned depth bucket capacities.
+    size_t counters = 0;
+    // Vertex and edge property columns, without heap held by their values.
+    size_t properties = 0;
+
+    size_t total() const {
+      return vertices + edges + adjacency + neighbor_sets + depths + counters +
+             properties;
+    }
+  };
+
+  // Expected size of a graph, used to allocate its containers up front.
+  struct Capacity {
+    size_t vertices_count = 0;
+    // Edges of every color but grey, grey edges are one per vertex.
+    size_t non_grey_edges_count = 0;
+    // Indexed by depth.
+    std::vector<size_t> depth_vertices_counts;
+  };
+
+  // Secondary indices kept up to date on every insert. A disabled index
+  // costs neither memory nor insert time: queries it answers either fall
+  // back to scanning adjacency lists or throw std::logic_error.
+  struct Indices {
+    // Answers is_vertices_connected() without scanning adjacency lists.
+    bool neighbor_sets = true;
+    // Answers get_depth_vertex_ids(), which throws when it is disabled.
+    bool depth_buckets = true;
+  };
+
+  Graph() : Graph(std::pmr::get_default_resource()) {}
+
+  // All containers of the graph allocate from the given memory resource,
+  // which has to outlive the graph.
+  explicit Graph(std::pmr::memory_resource* memory_resource);
+  Graph(std::pmr::memory_resource* memory_resource, const Indices& indices);
+
+  // Same as above, but the graph keeps the memory resource alive, so an
+  // arena can be released in one shot together with the graph.
+  explicit Graph(std::shared_ptr<std::pmr::memory_resource> memory_resource);
+  Graph(std::shared_ptr<std::pmr::memory_resource> memory_resource,
+        const Indices& indices);
+
+  // Per-edge storage, the bulk of a large graph, allocates from a resource
+  // of its own, for instance an arena of file mapped segments: the edge
+  // columns, adjacency lists and neighbor sets. The vertices, depth indices,
+  // counters and properties stay on the main one.
+  Graph(std::pmr::memory_resource* memory_resource,
+        const Indices& indices,
+        std::pmr::memory_resource* edges_memory_resource);
+  Graph(std::shared_ptr<std::pmr::memory_resource> memory_resource,
+        const Indices& indices,
+        std::shared_ptr<std::pmr::memory_resource> edges_memory_resource);
+
+  // Moving hands the memory resources over together with the containers
+  // allocated from them. Assignment is deleted: the containers would be
+  // assigned element by element into the resources of the assigned-to
+  // graph, which it releases. Copies go through copy_to_new_arena().
+  Graph(Graph&& other) = default;
+  Graph(const Graph& other) = delete;
+  Graph& operator=(Graph&& other) = delete;
+  Graph& operator=(const Graph& other) = delete;
+
+  // Deep copies the graph into a new monotonic arena on the upstream of its
+  // own one, so that the copy neither grows the arena of this graph nor
+  // keeps it alive. Per-edge storage on a resource of its own, segment
+  // files for instance, is copied onto that resource.
+  Graph copy_to_new_arena() const;
+
+  const Indices& get_indices() const;
+
+  // Summary counters, kept up to date on every insert.
+  size_t get_depth_vertices_count(Depth depth) const;
+  // Edges are counted at the depth of their source vertex.
+  size_t get_depth_color_edges_count(Depth depth, Edge::Color color) const;
+
+  // Reserves room for the given number of vertices and edges, so the graph
+  // grows up to that size without reallocating. Depth buckets that do not
+  // exist yet get their room once the graph reaches their depth.
+  void reserve(const Capacity& capacity);
+
   VertexId add_vertex();
 
+  // Throws std::logic_error while removals are pending, see compact().
   EdgeId add_edge(VertexId from_vertex_id, VertexId to_vertex_id);
 
+  // Removals only mark entries with tombstones, in O(1) per edge, until
+  // compact() drops them. Meanwhile edge iteration and the summary counters
+  // leave removed entries out, while the vertex list, adjacency lists, depth
+  // buckets and neighbor sets still hold them. Removing an entry that does
+  // not exist or is removed already throws std::invalid_argument.
+  void remove_edge(EdgeId edge_id);
+  // Removes the vertex with all of its edges. Its children lose their grey
+  // edge and stay at their depth without a parent.
+  void remove_vertex(VertexId vertex_id);
+  bool is_vertex_removed(VertexId vertex_id) const;
+  bool has_removed_entries() const;
+
+  // Unites the graphs into one forest: the vertex ids of every graph are
+  // shifted past those of the graphs before it, and its edge ids follow.
+  // Colors, depths and properties are copied instead of recomputed, on all
+  // hardware threads but for properties and neighbor sets. The graphs must
+  // share their indices and have no pending removals, the result allocates
+  // from the default memory resource. Properties of the same name must have
+  // the same type, else std::logic_error is thrown.
+  static Graph merge(Span<const Graph> graphs);
+  static Graph merge(Span<const Graph* const> graphs);
+
+  // Drops removed entries, renumbers the remaining vertices and edges
+  // densely in their order and rebuilds the indices. Property values follow
+  // their entries. Renumbering runs on all hardware threads.
+  void compact();
+
   Depth get_depth() const;
 
-  const std::vector<VertexId>& get_depth_vertex_ids(Depth depth) const;
+  Span<const VertexId> get_depth_vertex_ids(Depth depth) const;
 
-  const std::vector<EdgeId>& get_connected_edge_ids(VertexId vertex_id) const;
+  ConnectedEdgeIds get_connected_edge_ids(VertexId vertex_id) const;
 
   bool is_vertices_connected(VertexId first_vertex_id,
                              VertexId second_vertex_id) const;
 
   Depth get_vertex_depth(VertexId vertex_id) const;
 
-  const std::unordered_map<Graph::VertexId, Graph::Vertex>& get_vertices()
-      const;
+  const std::pmr::vector<Graph::Vertex>& get_vertices() const;
+
+  const EdgeTable& get_edges() const;
+
+  std::pmr::memory_resource* get_memory_resource() const;
+
+  MemoryUsage memory_usage() const;
+
+  // Typed attribute columns, indexed by vertex or edge id and allocated from
+  // the graph memory resource. Adding a property that exists throws
+  // std::invalid_argument, getting a missing one throws std::out_of_range
+  // and getting one with another type throws std::logic_error.
+  template <typename T>
+  PropertyMap<T>& add_vertex_property(const std::string& name,
+                                      T default_value = T()) {
+    return add_property(vertex_properties_, name, std::move(default_value),
+                        get_memory_resource());
+  }
+  template <typename T>
+  PropertyMap<T>& get_vertex_property(const std::string& name) {
+    return get_property<T>(vertex_properties_, name);
+  }
+  template <typename T>
+  const PropertyMap<T>& get_vertex_property(const std::string& name) const {
+    return get_property<T>(vertex_properties_, name);
+  }
+  const PropertyMaps& get_vertex_properties() const;
 
-  const std::unordered_map<Graph::EdgeId, Graph::Edge>& get_edges() const;
+  template <typename T>
+  PropertyMap<T>& add_edge_property(const std::string& name,
+                                    T default_value = T()) {
+    return add_property(edge_properties_, name, std::move(default_value),
+                        get_memory_resource());
+  }
+  template <typename T>
+  PropertyMap<T>& get_edge_property(const std::string& name) {
+    return get_property<T>(edge_properties_, name);
+  }
+  template <typename T>
+  const PropertyMap<T>& get_edge_property(const std::string& name) const {
+    return get_property<T>(edge_properties_, name);
+  }
+  const PropertyMaps& get_edge_properties() const;
+
+  // Builds a read-only compressed snapshot of the graph for consumers that
+  // no longer mutate it. Throws std::logic_error while removals are pending.
+  FrozenGraph freeze() const;
+
+  // Vertex ids in breadth-first order of the grey tree, level by level, so
+  // that every depth forms one contiguous block.
+  std::vector<VertexId> get_depth_order() const;
+
+  // Renumbers vertices in get_depth_order() order and remaps edges, so the
+  // vertices of every depth get consecutive ids. Throws std::logic_error
+  // while removals are pending.
+  void relabel_vertices_by_depth();
 
  private:
-  VertexId get_new_vertex_id();
+  std::pmr::memory_resource* get_edges_memory_resource() const {
+    return edges_.get_memory_resource();
+  }
 
-  EdgeId get_new_edge_id();
+  // Deep copies the other graph into containers on the given resources.
+  Graph(const Graph& other,
+        std::shared_ptr<std::pmr::memory_resource> memory_resource,
+        std::shared_ptr<std::pmr::memory_resource> edges_memory_resource);
+
+  VertexId get_new_vertex_id();
 
   Edge::Color determine_edge_color(VertexId from_vertex_id,
                                    VertexId to_vertex_id) const;
 
   void set_vertex_depth(VertexId vertex_id, Depth depth);
 
+  void add_depth();
+
+  bool is_vertices_connected_by_scan(VertexId first_vertex_id,
+                                     VertexId second_vertex_id) const;
+
+  // Declared first so that owned resources outlive the containers below.
+  std::shared_ptr<std::pmr::memory_resource> owned_memory_resource_;
+  std::shared_ptr<std::pmr::memory_resource> owned_edges_memory_resource_;
+  Indices indices_;
+
+  // Vertex ids are handed out densely starting from zero, so every
+  // per-vertex container below is a plain vector indexed by id.
   VertexId next_free_vertex_id_ = 0;
-  EdgeId next_free_edge_id_ = 0;
-  std::unordered_map<VertexId, Vertex> vertices_;
-  std::unordered_map<EdgeId, Edge> edges_;
-  std::unordered_map<VertexId, std::vector<EdgeId>> adjacency_list_;
-  std::unordered_map<VertexId, Depth> vertex_depths_list_;
-  std::vector<std::vector<VertexId>> depth_vertices_list_ = {{}};
+  std::pmr::vector<Vertex> vertices_;
+  EdgeTable edges_;
+  // Grey edges are listed only at their parent vertex, see ConnectedEdgeIds.
+  std::pmr::vector<std::pmr::vector<EdgeId>> adjacency_list_;
+  std::pmr::vector<NeighborSet<VertexId>> neighbor_sets_;
+  std::pmr::vector<Depth> vertex_depths_list_;
+  // With depth buckets disabled the buckets are still created, empty, so
+  // that their count keeps tracking the graph depth.
+  std::pmr::vector<std::pmr::vector<VertexId>> depth_vertices_list_;
+  // Index of every vertex inside its depth bucket, so moving a vertex to
+  // another depth is a swap with the bucket's last element.
+  std::pmr::vector<size_t> vertex_depth_positions_;
+  // Sizes reserved for depth buckets, applied when a bucket is created.
+  std::pmr::vector<size_t> depth_vertices_capacities_;
+  std::pmr::vector<size_t> depth_vertices_counts_;
+  std::pmr::vector<std::array<size_t, Edge::kColorsCount>>
+      depth_color_edges_counts_;
+  PropertyMaps vertex_properties_;
+  PropertyMaps edge_properties_;
+  // Tombstones indexed by vertex id, allocated by the first removal.
+  std::pmr::vector<bool> removed_vertices_;
+  size_t removed_vertices_count_ = 0;
 };
 
 static constexpr Graph::Depth kGraphDefaultDepth = 1;
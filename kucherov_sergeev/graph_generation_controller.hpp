@@ -8,12 +8,16 @@
 
 #include "graph.hpp"
 #include "graph_generator.hpp"
+#include "graph_handle.hpp"
 
 namespace uni_course_cpp {
 class GraphGenerationController {
  public:
   using GenStartedCallback = std::function<void(int index)>;
-  using GenFinishedCallback = std::function<void(int index, Graph&& graph)>;
+  // The handle is the only owner of the graph, the callback may keep copies
+  // of it without copying the graph.
+  using GenFinishedCallback =
+      std::function<void(int index, GraphHandle graph)>;
 
   GraphGenerationController(int threads_count,
                             int graphs_count,
@@ -1,14 +1,20 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
-#include <functional>
-#include <list>
+#include <cmath>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <optional>
 #include <random>
 #include <thread>
 
+#include "config.hpp"
+#include "file_mapped_memory_resource.hpp"
 #include "graph.hpp"
 #include "graph_generator.hpp"
+#include "graph_views.hpp"
+#include "huge_page_memory_resource.hpp"
 
 namespace uni_course_cpp {
 namespace {
@@ -17,6 +23,25 @@ static constexpr float kEdgeGreenProbability = 0.1;
 static constexpr float kEdgeRedProbability = 0.33;
 static constexpr Graph::Depth kYellowEdgeLength = 1;
 static constexpr Graph::Depth kRedEdgeLength = 2;
+// Generated sizes fluctuate around the expectation, the margin keeps most
+// graphs within the reserved capacity.
+static constexpr float kCapacityMargin = 1.25;
+// Every vertex gets at most one green, one yellow and one red edge.
+static constexpr size_t kMaxNonGreyEdgesPerVertex = 3;
+
+float get_new_vertex_probability(Graph::Depth current_depth,
+                                 Graph::Depth graph_depth) {
+  return 1.f - (current_depth - 1.f) / (graph_depth - 1.f);
+}
+
+float get_yellow_edge_probability(Graph::Depth current_depth,
+                                  Graph::Depth graph_depth) {
+  return current_depth / (graph_depth - 1.f);
+}
+
+size_t add_capacity_margin(float expected_count) {
+  return std::ceil(expected_count * kCapacityMargin);
+}
 
 bool get_random_bool(float true_probability) {
   std::random_device random_device;
@@ -25,22 +50,34 @@ bool get_random_bool(float true_probability) {
   return bernoulli_distribution(generator);
 }
 
-std::vector<Graph::VertexId> get_unconnected_vertex_ids(
-    const Graph& graph,
-    Graph::VertexId vertex_id) {
-  std::vector<Graph::VertexId> unconnected_vertex_ids = {};
-  for (const auto next_depth_vertex_id :
-       graph.get_depth_vertex_ids(graph.get_vertex_depth(vertex_id) + 1)) {
-    if (!graph.is_vertices_connected(vertex_id, next_depth_vertex_id)) {
-      unconnected_vertex_ids.push_back(next_depth_vertex_id);
-    }
+// Picks uniformly from a lazy range without collecting it: one pass counts
+// the candidates, a single draw picks an index and a second pass walks to
+// it.
+template <typename VertexIds>
+std::optional<Graph::VertexId> pick_random_vertex_id(
+    const VertexIds& vertex_ids) {
+  size_t vertices_count = 0;
+  for (auto iterator = vertex_ids.begin(); iterator != vertex_ids.end();
+       ++iterator) {
+    vertices_count++;
+  }
+  if (vertices_count == 0) {
+    return std::nullopt;
   }
 
-  return unconnected_vertex_ids;
+  std::random_device random_device;
+  std::mt19937 generator(random_device());
+  std::uniform_int_distribution<size_t> uniform_int_distribution(
+      0, vertices_count - 1);
+
+  auto iterator = vertex_ids.begin();
+  for (auto index = uniform_int_distribution(generator); index > 0; index--) {
+    ++iterator;
+  }
+  return *iterator;
 }
 
-Graph::VertexId get_random_vertex_id(
-    const std::vector<Graph::VertexId>& vertex_ids) {
+Graph::VertexId get_random_vertex_id(Span<const Graph::VertexId> vertex_ids) {
   assert((!vertex_ids.empty()) &&
          "Can't pick random vertex id from empty list");
 
@@ -75,7 +112,8 @@ void generate_yellow_edges(Graph& graph, std::mutex& graph_mutex) {
 
   for (Graph::Depth current_depth = kGraphDefaultDepth;
        current_depth <= graph_depth - kYellowEdgeLength; current_depth++) {
-    float new_edge_probability = current_depth / (graph_depth - 1.f);
+    float new_edge_probability =
+        get_yellow_edge_probability(current_depth, graph_depth);
 
     const auto& current_depth_vertex_ids =
         graph.get_depth_vertex_ids(current_depth);
@@ -87,13 +125,11 @@ void generate_yellow_edges(Graph& graph, std::mutex& graph_mutex) {
            new_edge_probability](Graph::VertexId vertex_id) {
             if (get_random_bool(new_edge_probability)) {
               const std::lock_guard lock(graph_mutex);
-              const auto& to_vertex_ids =
-                  get_unconnected_vertex_ids(graph, vertex_id);
-
-              if (to_vertex_ids.empty() == false) {
-                const auto to_vertex_id = get_random_vertex_id(to_vertex_ids);
+              const auto to_vertex_id = pick_random_vertex_id(
+                  views::unconnected_vertex_ids(graph, vertex_id));
 
-                graph.add_edge(vertex_id, to_vertex_id);
+              if (to_vertex_id.has_value()) {
+                graph.add_edge(vertex_id, *to_vertex_id);
               }
             }
           });
@@ -129,38 +165,113 @@ void generate_red_edges(Graph& graph, std::mutex& graph_mutex) {
 }
 }  // namespace
 
-void GraphGenerator::generate_grey_branch(Graph& graph,
+void GraphGenerator::generate_grey_branch(ConcurrentGraph& graph,
                                           Graph::VertexId root_vertex_id,
-                                          Graph::Depth current_depth,
-                                          std::mutex& graph_mutex) const {
+                                          Graph::Depth current_depth) const {
   const float new_vertex_probability =
-      1.f - (current_depth - 1.f) / (params_.depth() - 1.f);
+      get_new_vertex_probability(current_depth, params_.depth());
 
   if (!get_random_bool(new_vertex_probability)) {
     return;
   }
 
-  const auto new_vertex_id = [&graph_mutex, &graph, root_vertex_id]() {
-    const std::lock_guard lock(graph_mutex);
-    const auto new_vertex_id = graph.add_vertex();
-    graph.add_edge(root_vertex_id, new_vertex_id);
-    return new_vertex_id;
-  }();
+  const auto new_vertex_id = graph.add_vertex(root_vertex_id);
 
   for (int attempt = 0; attempt < params_.new_vertices_count(); attempt++) {
     if (current_depth < params_.depth()) {
-      generate_grey_branch(graph, new_vertex_id, current_depth + 1,
-                           graph_mutex);
+      generate_grey_branch(graph, new_vertex_id, current_depth + 1);
+    }
+  }
+}
+
+Graph::Capacity GraphGenerator::estimate_capacity() const {
+  const auto graph_depth = params_.depth();
+  auto capacity = Graph::Capacity();
+  if (graph_depth < kGraphDefaultDepth) {
+    return capacity;
+  }
+
+  // Every vertex above the last depth makes new_vertices_count() attempts
+  // to grow a child, each succeeding with the new vertex probability.
+  auto depth_vertices_counts = std::vector<float>(graph_depth + 1, 0);
+  depth_vertices_counts[kGraphDefaultDepth] = 1;
+  for (Graph::Depth depth = kGraphDefaultDepth; depth < graph_depth; depth++) {
+    depth_vertices_counts[depth + 1] =
+        depth_vertices_counts[depth] * params_.new_vertices_count() *
+        get_new_vertex_probability(depth, graph_depth);
+  }
+
+  capacity.depth_vertices_counts.resize(graph_depth + 1);
+  float vertices_count = 0;
+  float non_grey_edges_count = 0;
+  for (Graph::Depth depth = kGraphDefaultDepth; depth <= graph_depth;
+       depth++) {
+    const auto count = depth_vertices_counts[depth];
+    vertices_count += count;
+    non_grey_edges_count += count * kEdgeGreenProbability;
+    if (depth <= graph_depth - kYellowEdgeLength) {
+      non_grey_edges_count +=
+          count * get_yellow_edge_probability(depth, graph_depth);
+    }
+    if (depth <= graph_depth - kRedEdgeLength) {
+      non_grey_edges_count += count * kEdgeRedProbability;
     }
+    capacity.depth_vertices_counts[depth] = add_capacity_margin(count);
   }
+
+  capacity.vertices_count = add_capacity_margin(vertices_count);
+  capacity.non_grey_edges_count = add_capacity_margin(non_grey_edges_count);
+  return capacity;
 }
 
 Graph GraphGenerator::generate() const {
-  auto graph = Graph();
+  // Every graph gets its own arena: generation threads of different graphs
+  // do not contend on the global heap, and the whole graph is released in
+  // one shot when it is destroyed.
+  // The yellow phase searches the next depth for vertices that are not yet
+  // connected, which needs both the depth buckets and the neighbor sets.
+  auto indices = Graph::Indices();
+  indices.neighbor_sets = true;
+  indices.depth_buckets = true;
+  // Chunks of at least a huge page, the reserved arrays among them, come
+  // from huge pages when the params ask for it and they are available.
+  auto* upstream_memory_resource =
+      params_.allocation_mode() == AllocationMode::HugePages
+          ? get_huge_page_memory_resource()
+          : std::pmr::get_default_resource();
+  const auto memory_resource =
+      std::shared_ptr<std::pmr::memory_resource>(
+          std::make_shared<std::pmr::monotonic_buffer_resource>(
+              upstream_memory_resource));
+  // Spilled per-edge storage lives in segment files and leaves only the
+  // vertices and depth indices in memory.
+  const auto is_spilling = params_.spill_mode() == SpillMode::EdgesToDisk;
+  const auto edges_memory_resource =
+      is_spilling ? make_file_mapped_arena(config::kEdgeSegmentsDirectoryPath)
+                  : memory_resource;
+  auto graph = Graph(memory_resource, indices, edges_memory_resource);
 
   if (params_.depth() != 0) {
-    const auto root_id = graph.add_vertex();
-    generate_grey_edges(graph, root_id);
+    auto grey_graph = ConcurrentGraph();
+    const auto root_id = grey_graph.add_vertex();
+    generate_grey_edges(grey_graph, root_id);
+
+    // The expected size is allocated up front, so neither copying the tree
+    // nor the color phases, which hold the graph mutex, regrow containers.
+    auto capacity = estimate_capacity();
+    if (is_spilling) {
+      // A regrown spilled column keeps its old segments until the graph is
+      // destroyed, so the columns are reserved for the most edges the tree
+      // can get rather than for the expected ones. Segment files are
+      // sparse: capacity that is never written takes no disk space.
+      capacity.vertices_count = grey_graph.get_vertices_count();
+      capacity.non_grey_edges_count =
+          capacity.vertices_count * kMaxNonGreyEdgesPerVertex;
+    }
+    graph.reserve(capacity);
+    // Breadth-first copying gives every depth consecutive ids, which the
+    // color phases sweep.
+    grey_graph.copy_to(graph);
 
     std::mutex graph_mutex;
 
@@ -182,52 +293,19 @@ Graph GraphGenerator::generate() const {
   return graph;
 }
 
-void GraphGenerator::generate_grey_edges(Graph& graph,
+void GraphGenerator::generate_grey_edges(ConcurrentGraph& graph,
                                          Graph::VertexId root_id) const {
-  std::mutex jobs_mutex, graph_mutex;
-
-  using JobCallback = std::function<void()>;
-  auto jobs = std::list<JobCallback>();
-
-  for (int i = 0; i < params_.new_vertices_count(); i++) {
-    jobs.push_back([&graph, root_id, &graph_mutex, this]() {
-      generate_grey_branch(graph, root_id, graph.get_vertex_depth(root_id),
-                           graph_mutex);
-    });
-  }
-
-  std::atomic<bool> should_terminate = false;
-  std::atomic<int> jobs_count = jobs.size();
-
-  const auto worker = [&should_terminate, &jobs_mutex, &jobs_count, &jobs]() {
-    while (true) {
-      if (should_terminate) {
-        return;
-      }
-
-      const auto job_optional = [&jobs, &jobs_count,
-                                 &jobs_mutex]() -> std::optional<JobCallback> {
-        const std::lock_guard lock(jobs_mutex);
-
-        if (!jobs.empty()) {
-          auto job = jobs.back();
-          jobs.pop_back();
-          jobs_count = jobs.size();
-          return job;
-        }
-        return std::nullopt;
-      }();
-
-      const std::lock_guard lock(jobs_mutex);
-      if (job_optional.has_value()) {
-        const auto& job = job_optional.value();
-        job();
-      }
+  // Every branch growing from the root is a job. Workers claim jobs from a
+  // shared counter and return once none are left.
+  std::atomic<int> next_branch = 0;
+  const auto worker = [&graph, root_id, &next_branch, this]() {
+    while (next_branch++ < params_.new_vertices_count()) {
+      generate_grey_branch(graph, root_id, graph.get_vertex_depth(root_id));
     }
   };
 
   const auto threads_count =
-      std::min(kMaxThreadsCount, params_.new_vertices_count());
+      std::min(std::max(kMaxThreadsCount, 1), params_.new_vertices_count());
   auto threads = std::vector<std::thread>();
   threads.reserve(threads_count);
 
@@ -235,10 +313,6 @@ void GraphGenerator::generate_grey_edges(Graph& graph,
     threads.emplace_back(worker);
   }
 
-  while (jobs_count > 0) {
-  }
-
-  should_terminate = true;
   for (auto& thread : threads) {
     thread.join();
   }
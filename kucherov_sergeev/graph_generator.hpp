@@ -1,34 +1,58 @@
 #pragma once
 
-#include <mutex>
+#include "concurrent_graph.hpp"
 #include "graph.hpp"
 
 namespace uni_course_cpp {
 class GraphGenerator {
  public:
+  // Where the arena of a generated graph gets its chunks from. Huge pages
+  // are opt-in: every mapping is rounded up to 2 MiB, which only pays off
+  // for large graphs.
+  enum class AllocationMode { Default, HugePages };
+  // Where the per-edge storage of a generated graph lives: the edge columns,
+  // adjacency lists and neighbor sets. EdgesToDisk puts it in memory mapped
+  // segment files under config::kEdgeSegmentsDirectoryPath, which the kernel
+  // writes back to disk instead of keeping resident. Vertices and depth
+  // indices stay in memory, and so does the grey tree while it is grown.
+  enum class SpillMode { Off, EdgesToDisk };
+
   struct Params {
    public:
-    Params(Graph::Depth depth, int new_vertices_count)
-        : depth_(depth), new_vertices_count_(new_vertices_count) {}
+    Params(Graph::Depth depth,
+           int new_vertices_count,
+           AllocationMode allocation_mode = AllocationMode::Default,
+           SpillMode spill_mode = SpillMode::Off)
+        : depth_(depth),
+          new_vertices_count_(new_vertices_count),
+          allocation_mode_(allocation_mode),
+          spill_mode_(spill_mode) {}
 
     Graph::Depth depth() const { return depth_; }
     int new_vertices_count() const { return new_vertices_count_; }
+    AllocationMode allocation_mode() const { return allocation_mode_; }
+    SpillMode spill_mode() const { return spill_mode_; }
 
    private:
     Graph::Depth depth_ = 0;
     int new_vertices_count_ = 0;
+    AllocationMode allocation_mode_ = AllocationMode::Default;
+    SpillMode spill_mode_ = SpillMode::Off;
   };
 
   explicit GraphGenerator(Params&& params) : params_(std::move(params)) {}
 
   Graph generate() const;
 
+  // Expected size of a generated graph with a safety margin on top.
+  Graph::Capacity estimate_capacity() const;
+
  private:
-  void generate_grey_edges(Graph& graph, Graph::VertexId root_id) const;
-  void generate_grey_branch(Graph& graph,
+  void generate_grey_edges(ConcurrentGraph& graph,
+                           Graph::VertexId root_id) const;
+  void generate_grey_branch(ConcurrentGraph& graph,
                             Graph::VertexId root_vertex_id,
-                            Graph::Depth current_depth,
-                            std::mutex& graph_mutex) const;
+                            Graph::Depth current_depth) const;
 
   Params params_ = Params(0, 0);
 };
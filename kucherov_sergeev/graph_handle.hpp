@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+
+#include "graph.hpp"
+
+namespace uni_course_cpp {
+// Reference counted handle to a graph that is treated as immutable. Copying
+// a handle shares the graph, so any number of consumers read one instance.
+// mutate() deep copies the graph first unless this handle is its only owner
+// (copy-on-write), leaving the other handles untouched. The copy gets an
+// arena of its own, so the arena of the shared graph is released with the
+// last handle that still refers to it.
+// A single handle is not thread safe, distinct handles to one graph are.
+class GraphHandle {
+ public:
+  explicit GraphHandle(Graph&& graph)
+      : graph_(std::make_shared<Graph>(std::move(graph))) {}
+
+  const Graph& operator*() const { return *graph_; }
+  const Graph* operator->() const { return graph_.get(); }
+
+  // Number of handles sharing the graph.
+  long use_count() const { return graph_.use_count(); }
+
+  Graph& mutate() {
+    if (graph_.use_count() != 1) {
+      graph_ = std::make_shared<Graph>(graph_->copy_to_new_arena());
+    }
+
+    return *graph_;
+  }
+
+ private:
+  std::shared_ptr<Graph> graph_;
+};
+}  // namespace uni_course_cpp
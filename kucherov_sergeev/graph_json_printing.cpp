@@ -1,71 +1,245 @@
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
 #include "graph_json_printing.hpp"
 #include "graph_printing.hpp"
 
 namespace uni_course_cpp {
 namespace printing {
 namespace json {
-std::string print_vertex(const Graph::Vertex& vertex, const Graph& graph) {
-  std::string vertex_json =
-      "{\"id\":" + std::to_string(vertex.id()) + ",\"edge_ids\":[";
-  const auto& connected_edge_ids = graph.get_connected_edge_ids(vertex.id());
+namespace {
+std::string print_property_value(int64_t value) {
+  return std::to_string(value);
+}
 
-  if (connected_edge_ids.size() != 0) {
-    for (const auto edge_id : connected_edge_ids) {
-      vertex_json += std::to_string(edge_id) + ",";
+std::string print_property_value(double value) {
+  if (!std::isfinite(value)) {
+    return "null";
+  }
+  auto value_json = std::ostringstream();
+  value_json << std::setprecision(std::numeric_limits<double>::max_digits10)
+             << value;
+  return value_json.str();
+}
+
+std::string print_property_value(const std::string& value) {
+  std::string value_json = "\"";
+  for (const char character : value) {
+    if (character == '"' || character == '\\') {
+      value_json += '\\';
+      value_json += character;
+    } else if (static_cast<unsigned char>(character) < 0x20) {
+      char escaped[7];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", character);
+      value_json += escaped;
+    } else {
+      value_json += character;
     }
+  }
+  return value_json + "\"";
+}
 
-    vertex_json.pop_back();
+// Empty for graphs without properties, so their JSON does not change.
+std::string print_properties(const PropertyMaps& properties, size_t id) {
+  if (properties.empty()) {
+    return "";
   }
 
-  vertex_json +=
-      "],\"depth\":" + std::to_string(graph.get_vertex_depth(vertex.id()));
+  std::string properties_json = ",\"properties\":{";
+  for (const auto& [name, property] : properties) {
+    properties_json += print_property_value(name) + ":" +
+                       std::visit(
+                           [id](const auto& property_map) {
+                             return print_property_value(property_map[id]);
+                           },
+                           property) +
+                       ",";
+  }
+  properties_json.back() = '}';
 
-  vertex_json += "}";
+  return properties_json;
+}
 
-  return vertex_json;
+// Graph edge ids encode where an edge is stored, 2 * v for the grey edge of
+// vertex v and 2 * k + 1 for the k-th other edge, so a printed graph numbers
+// its edges 0..E-1 in the order they are listed instead.
+class DenseEdgeIds {
+ public:
+  template <typename Edges>
+  explicit DenseEdgeIds(const Edges& edges) {
+    Graph::EdgeId edges_count = 0;
+    for (const auto& edge : edges) {
+      if (edge.id() >= dense_edge_ids_.size()) {
+        dense_edge_ids_.resize(edge.id() + 1, kNoEdgeId);
+      }
+      dense_edge_ids_[edge.id()] = edges_count++;
+    }
+  }
+
+  bool contains(Graph::EdgeId edge_id) const {
+    return edge_id < dense_edge_ids_.size() &&
+           dense_edge_ids_[edge_id] != kNoEdgeId;
+  }
+  Graph::EdgeId operator[](Graph::EdgeId edge_id) const {
+    return dense_edge_ids_[edge_id];
+  }
+
+ private:
+  static constexpr Graph::EdgeId kNoEdgeId =
+      std::numeric_limits<Graph::EdgeId>::max();
+
+  std::vector<Graph::EdgeId> dense_edge_ids_;
+};
+
+// Prints graph edge ids unless the dense ids of the whole graph are given.
+std::string print_edge_id(Graph::EdgeId edge_id,
+                          const DenseEdgeIds* dense_edge_ids) {
+  return std::to_string(dense_edge_ids ? (*dense_edge_ids)[edge_id]
+                                       : edge_id);
 }
 
-std::string print_edge(const Graph::Edge& edge) {
-  std::string edge_json =
-      "{\"id\":" + std::to_string(edge.id()) + ",\"vertex_ids\":[";
+std::string print_edge_impl(const Graph::Edge& edge,
+                            const std::string& properties_json,
+                            const DenseEdgeIds* dense_edge_ids) {
+  std::string edge_json = "{\"id\":" +
+                          print_edge_id(edge.id(), dense_edge_ids) +
+                          ",\"vertex_ids\":[";
 
   edge_json += std::to_string(edge.from_vertex_id()) + "," +
                std::to_string(edge.to_vertex_id());
   edge_json += "],\"color\":\"" + print_edge_color(edge.color()) + "\"";
-  edge_json += "}";
+  edge_json += properties_json + "}";
 
   return edge_json;
 }
 
-std::string print_graph(const Graph& graph) {
-  const auto& vertices = graph.get_vertices();
-  const auto& edges = graph.get_edges();
+template <typename GraphType>
+std::string print_vertex_impl(const Graph::Vertex& vertex,
+                              const GraphType& graph,
+                              const DenseEdgeIds* dense_edge_ids) {
+  std::string vertex_json =
+      "{\"id\":" + std::to_string(vertex.id()) + ",\"edge_ids\":[";
+  const char* separator = "";
+  for (const auto edge_id : graph.get_connected_edge_ids(vertex.id())) {
+    // Removed edges are still listed at their vertices, but not printed.
+    if (dense_edge_ids && !dense_edge_ids->contains(edge_id)) {
+      continue;
+    }
+    vertex_json += separator + print_edge_id(edge_id, dense_edge_ids);
+    separator = ",";
+  }
 
-  std::string graph_json =
-      "{\n\t\"depth\":" + std::to_string(graph.get_depth()) + ",";
+  vertex_json +=
+      "],\"depth\":" + std::to_string(graph.get_vertex_depth(vertex.id()));
 
-  graph_json += "\n\t\"vertices\": [\n";
-  if (vertices.size() != 0) {
-    for (const auto& [vertex_id, vertex] : vertices) {
-      graph_json += "\t\t" + print_vertex(vertex, graph) + ",\n";
-    }
-    graph_json.pop_back();
-    graph_json.pop_back();
+  // Frozen graphs carry no properties.
+  if constexpr (!std::is_same_v<GraphType, FrozenGraph>) {
+    vertex_json += print_properties(graph.get_vertex_properties(), vertex.id());
   }
 
-  graph_json += "\n\t],\n\t\"edges\":[\n";
+  vertex_json += "}";
 
-  if (edges.size() != 0) {
-    for (const auto& [edge_id, edge] : edges) {
-      graph_json += "\t\t" + print_edge(edge) + ",\n";
+  return vertex_json;
+}
+
+// Writes vertices and edges one by one, so the whole document never has to
+// fit in memory, which matters for graphs with edges spilled to disk.
+template <typename GraphType>
+void print_graph_impl(std::ostream& output, const GraphType& graph) {
+  // One id per edge is the only thing held besides the graph.
+  const auto dense_edge_ids = DenseEdgeIds(graph.get_edges());
+
+  output << "{\n\t\"depth\":" << graph.get_depth() << ",";
+
+  output << "\n\t\"vertices\": [\n";
+  const char* separator = "";
+  for (const auto& vertex : graph.get_vertices()) {
+    output << separator << "\t\t"
+           << print_vertex_impl(vertex, graph, &dense_edge_ids);
+    separator = ",\n";
+  }
+
+  output << "\n\t],\n\t\"edges\":[\n";
+  separator = "";
+  for (const auto& edge : graph.get_edges()) {
+    auto properties_json = std::string();
+    if constexpr (!std::is_same_v<GraphType, FrozenGraph>) {
+      properties_json =
+          print_properties(graph.get_edge_properties(), edge.id());
     }
-    graph_json.pop_back();
-    graph_json.pop_back();
+    output << separator << "\t\t"
+           << print_edge_impl(edge, properties_json, &dense_edge_ids);
+    separator = ",\n";
   }
 
-  graph_json += "\n\t]\n}\n";
+  output << "\n\t]\n}\n";
+}
+
+template <typename GraphType>
+std::string print_graph_impl(const GraphType& graph) {
+  auto output = std::ostringstream();
+  print_graph_impl(output, graph);
+  return output.str();
+}
+}  // namespace
+
+std::string print_vertex(const Graph::Vertex& vertex, const Graph& graph) {
+  return print_vertex_impl(vertex, graph, nullptr);
+}
+
+std::string print_vertex(const Graph::Vertex& vertex,
+                         const FrozenGraph& graph) {
+  return print_vertex_impl(vertex, graph, nullptr);
+}
+
+std::string print_vertex(const Graph::Vertex& vertex, const GraphView& graph) {
+  return print_vertex_impl(vertex, graph, nullptr);
+}
+
+std::string print_edge(const Graph::Edge& edge) {
+  return print_edge_impl(edge, "", nullptr);
+}
+
+std::string print_edge(const Graph::Edge& edge, const Graph& graph) {
+  return print_edge_impl(
+      edge, print_properties(graph.get_edge_properties(), edge.id()),
+      nullptr);
+}
+
+std::string print_edge(const Graph::Edge& edge, const GraphView& graph) {
+  return print_edge_impl(
+      edge, print_properties(graph.get_edge_properties(), edge.id()),
+      nullptr);
+}
+
+std::string print_graph(const Graph& graph) {
+  return print_graph_impl(graph);
+}
+
+std::string print_graph(const FrozenGraph& graph) {
+  return print_graph_impl(graph);
+}
+
+std::string print_graph(const GraphView& graph) {
+  return print_graph_impl(graph);
+}
+
+void print_graph(std::ostream& output, const Graph& graph) {
+  print_graph_impl(output, graph);
+}
+
+void print_graph(std::ostream& output, const FrozenGraph& graph) {
+  print_graph_impl(output, graph);
+}
 
-  return graph_json;
+void print_graph(std::ostream& output, const GraphView& graph) {
+  print_graph_impl(output, graph);
 }
 }  // namespace json
 }  // namespace printing
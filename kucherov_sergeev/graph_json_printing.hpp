@@ -1,16 +1,37 @@
 #pragma once
 
+#include <ostream>
 #include <string>
+#include "frozen_graph.hpp"
 #include "graph.hpp"
+#include "graph_view.hpp"
 
 namespace uni_course_cpp {
 namespace printing {
 namespace json {
+// Single vertices and edges are printed with the edge ids of the graph.
 std::string print_vertex(const Graph::Vertex& vertex, const Graph& graph);
+std::string print_vertex(const Graph::Vertex& vertex,
+                         const FrozenGraph& graph);
+// Lists only the connected edges inside the view.
+std::string print_vertex(const Graph::Vertex& vertex, const GraphView& graph);
 
 std::string print_edge(const Graph::Edge& edge);
+// Includes the edge properties of the graph.
+std::string print_edge(const Graph::Edge& edge, const Graph& graph);
+std::string print_edge(const Graph::Edge& edge, const GraphView& graph);
 
+// Edges are numbered 0..E-1 in the order they are listed, which is the
+// order they were added in for generated graphs, rather than by the sparse
+// edge ids of the graph.
 std::string print_graph(const Graph& graph);
+std::string print_graph(const FrozenGraph& graph);
+std::string print_graph(const GraphView& graph);
+
+// Streams the same JSON as above without building it in memory.
+void print_graph(std::ostream& output, const Graph& graph);
+void print_graph(std::ostream& output, const FrozenGraph& graph);
+void print_graph(std::ostream& output, const GraphView& graph);
 }  // namespace json
 }  // namespace printing
 }  // namespace uni_course_cpp
@@ -9,51 +9,34 @@ static constexpr std::array<Graph::Edge::Color, 4> kEdgeColorList = {
     Graph::Edge::Color::Grey, Graph::Edge::Color::Green,
     Graph::Edge::Color::Yellow, Graph::Edge::Color::Red};
 
-std::vector<int> get_vertices_depth_distribution(const Graph& graph) {
+template <typename GraphType>
+std::vector<int> get_vertices_depth_distribution(const GraphType& graph) {
   std::vector<int> vertices_depth_distribution = {};
   const auto depth = graph.get_depth();
 
   for (Graph::Depth i = 0; i <= depth; i++) {
-    vertices_depth_distribution.push_back(graph.get_depth_vertex_ids(i).size());
+    vertices_depth_distribution.push_back(graph.get_depth_vertices_count(i));
   }
 
   return vertices_depth_distribution;
 }
 
+template <typename GraphType>
 std::map<Graph::Edge::Color, int> get_edges_color_distribution(
-    const Graph& graph) {
+    const GraphType& graph) {
   std::map<Graph::Edge::Color, int> edges_color_distribution;
 
-  for (const auto color : kEdgeColorList) {
-    edges_color_distribution[color] = 0;
-  }
-
   const auto& edges = graph.get_edges();
 
-  for (const auto& [edge_id, edge] : edges) {
-    edges_color_distribution[edge.color()] += 1;
+  for (const auto color : kEdgeColorList) {
+    edges_color_distribution[color] = edges.count_color(color);
   }
 
   return edges_color_distribution;
 }
-}  // namespace
 
-std::string print_edge_color(Graph::Edge::Color color) {
-  switch (color) {
-    case Graph::Edge::Color::Grey:
-      return "grey";
-    case Graph::Edge::Color::Green:
-      return "green";
-    case Graph::Edge::Color::Yellow:
-      return "yellow";
-    case Graph::Edge::Color::Red:
-      return "red";
-    default:
-      return "invalid color";
-  }
-}
-
-std::string print_vertices_info(const Graph& graph) {
+template <typename GraphType>
+std::string print_vertices_info_impl(const GraphType& graph) {
   const auto vertices_depth_distribution =
       get_vertices_depth_distribution(graph);
   std::string vertices_string =
@@ -72,7 +55,8 @@ std::string print_vertices_info(const Graph& graph) {
   return vertices_string;
 }
 
-std::string print_edges_info(const Graph& graph) {
+template <typename GraphType>
+std::string print_edges_info_impl(const GraphType& graph) {
   const auto edges_color_distribution = get_edges_color_distribution(graph);
   std::string edges_string =
       "edges: {amount: " + std::to_string(graph.get_edges().size()) +
@@ -91,7 +75,8 @@ std::string print_edges_info(const Graph& graph) {
   return edges_string;
 }
 
-std::string print_graph(const Graph& graph) {
+template <typename GraphType>
+std::string print_graph_impl(const GraphType& graph) {
   std::string depth_string =
       "depth: " + std::to_string(graph.get_depth()) + ",";
   std::string vertices_string = print_vertices_info(graph);
@@ -100,5 +85,80 @@ std::string print_graph(const Graph& graph) {
   return "{\n\t" + depth_string + "\n\t" + vertices_string + "\n\t" +
          edges_string + "\n}";
 }
+}  // namespace
+
+std::string print_edge_color(Graph::Edge::Color color) {
+  switch (color) {
+    case Graph::Edge::Color::Grey:
+      return "grey";
+    case Graph::Edge::Color::Green:
+      return "green";
+    case Graph::Edge::Color::Yellow:
+      return "yellow";
+    case Graph::Edge::Color::Red:
+      return "red";
+    default:
+      return "invalid color";
+  }
+}
+
+std::string print_vertices_info(const Graph& graph) {
+  return print_vertices_info_impl(graph);
+}
+
+std::string print_vertices_info(const FrozenGraph& graph) {
+  return print_vertices_info_impl(graph);
+}
+
+std::string print_vertices_info(const GraphView& graph) {
+  return print_vertices_info_impl(graph);
+}
+
+std::string print_edges_info(const Graph& graph) {
+  return print_edges_info_impl(graph);
+}
+
+std::string print_edges_info(const FrozenGraph& graph) {
+  return print_edges_info_impl(graph);
+}
+
+std::string print_edges_info(const GraphView& graph) {
+  return print_edges_info_impl(graph);
+}
+
+std::string print_graph(const Graph& graph) {
+  return print_graph_impl(graph);
+}
+
+std::string print_graph(const FrozenGraph& graph) {
+  return print_graph_impl(graph);
+}
+
+std::string print_graph(const GraphView& graph) {
+  return print_graph_impl(graph);
+}
+
+std::string print_memory_usage(const Graph::MemoryUsage& memory_usage) {
+  return "{total: " + std::to_string(memory_usage.total()) +
+         ", vertices: " + std::to_string(memory_usage.vertices) +
+         ", edges: " + std::to_string(memory_usage.edges) +
+         ", adjacency: " + std::to_string(memory_usage.adjacency) +
+         ", neighbor sets: " + std::to_string(memory_usage.neighbor_sets) +
+         ", depths: " + std::to_string(memory_usage.depths) +
+         ", counters: " + std::to_string(memory_usage.counters) +
+         ", properties: " + std::to_string(memory_usage.properties) +
+         "} bytes";
+}
+
+std::string print_memory_mode(HugePageMemoryResource::Mode mode) {
+  switch (mode) {
+    case HugePageMemoryResource::Mode::HugePages:
+      return "huge pages";
+    case HugePageMemoryResource::Mode::RegularPages:
+      return "regular pages";
+    default:
+      return "invalid mode";
+  }
+}
 }  // namespace printing
 }  // namespace uni_course_cpp
@@ -1,14 +1,25 @@
 #pragma once
 
 #include <string>
+#include "frozen_graph.hpp"
 #include "graph.hpp"
+#include "graph_view.hpp"
+#include "huge_page_memory_resource.hpp"
 
 namespace uni_course_cpp {
 namespace printing {
 std::string print_depth_info(Graph::Depth depth);
 std::string print_edges_info(const Graph& graph);
+std::string print_edges_info(const FrozenGraph& graph);
+std::string print_edges_info(const GraphView& graph);
 std::string print_edge_color(Graph::Edge::Color color);
 std::string print_vertices_info(const Graph& graph);
+std::string print_vertices_info(const FrozenGraph& graph);
+std::string print_vertices_info(const GraphView& graph);
 std::string print_graph(const Graph& graph);
+std::string print_graph(const FrozenGraph& graph);
+std::string print_graph(const GraphView& graph);
+std::string print_memory_usage(const Graph::MemoryUsage& memory_usage);
+std::string print_memory_mode(HugePageMemoryResource::Mode mode);
 }  // namespace printing
 }  // namespace uni_course_cpp
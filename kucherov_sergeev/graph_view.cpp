@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+#include "graph_view.hpp"
+
+namespace uni_course_cpp {
+namespace {
+// How much deeper than its source the target of an edge of the color is,
+// which add_edge() guarantees when it picks the color.
+Graph::Depth get_color_depth_span(Graph::Edge::Color color) {
+  switch (color) {
+    case Graph::Edge::Color::Grey:
+    case Graph::Edge::Color::Yellow:
+      return 1;
+    case Graph::Edge::Color::Green:
+      return 0;
+    case Graph::Edge::Color::Red:
+      return 2;
+  }
+  throw std::runtime_error("Failed to determine color depth span");
+}
+
+constexpr std::array<Graph::Edge::Color, Graph::Edge::kColorsCount>
+    kEdgeColors = {Graph::Edge::Color::Grey, Graph::Edge::Color::Green,
+                   Graph::Edge::Color::Yellow, Graph::Edge::Color::Red};
+}  // namespace
+
+void GraphView::Vertices::Iterator::skip_empty_depths() {
+  while (depth_ < end_depth_ &&
+         index_ >= graph_->get_depth_vertex_ids(depth_).size()) {
+    depth_++;
+    index_ = 0;
+  }
+}
+
+size_t GraphView::Vertices::size() const {
+  size_t vertices_count = 0;
+  for (auto depth = begin_depth_; depth < end_depth_; depth++) {
+    vertices_count += graph_->get_depth_vertex_ids(depth).size();
+  }
+  return vertices_count;
+}
+
+bool GraphView::EdgeFilter::operator()(GraphView::EdgeId edge_id) const {
+  // Targets are never shallower than sources.
+  const auto& edges = graph_->get_edges();
+  return graph_->get_vertex_depth(edges.from_vertex_id(edge_id)) >=
+             min_depth_ &&
+         graph_->get_vertex_depth(edges.to_vertex_id(edge_id)) <= max_depth_;
+}
+
+GraphView::EdgeTable::Iterator::Iterator(const GraphView& graph_view,
+                                         Vertices::Iterator vertex)
+    : graph_view_(&graph_view),
+      vertex_(vertex),
+      end_vertex_(graph_view.get_vertices().end()),
+      edge_id_(Graph::ConnectedEdgeIds().end()),
+      end_edge_id_(Graph::ConnectedEdgeIds().end()) {
+  if (vertex_ != end_vertex_) {
+    load_vertex_edges();
+    skip_rejected_edges();
+  }
+}
+
+void GraphView::EdgeTable::Iterator::load_vertex_edges() {
+  const auto connected_edge_ids =
+      graph_view_->graph_->get_connected_edge_ids(vertex_.get_vertex_id());
+  edge_id_ = connected_edge_ids.begin();
+  end_edge_id_ = connected_edge_ids.end();
+}
+
+void GraphView::EdgeTable::Iterator::skip_rejected_edges() {
+  const auto& edges = graph_view_->graph_->get_edges();
+  while (vertex_ != end_vertex_) {
+    const auto vertex_id = vertex_.get_vertex_id();
+    for (; edge_id_ != end_edge_id_; ++edge_id_) {
+      const auto edge_id = *edge_id_;
+      if (!edges.is_removed(edge_id) &&
+          edges.from_vertex_id(edge_id) == vertex_id &&
+          graph_view_->is_depth_in_view(graph_view_->get_vertex_depth(
+              edges.to_vertex_id(edge_id)))) {
+        return;
+      }
+    }
+
+    ++vertex_;
+    if (vertex_ == end_vertex_) {
+      edge_id_ = end_edge_id_ = Graph::ConnectedEdgeIds().end();
+    } else {
+      load_vertex_edges();
+    }
+  }
+}
+
+size_t GraphView::EdgeTable::size() const {
+  size_t edges_count = 0;
+  for (const auto color : kEdgeColors) {
+    edges_count += count_color(color);
+  }
+  return edges_count;
+}
+
+size_t GraphView::EdgeTable::count_color(Graph::Edge::Color color) const {
+  size_t edges_count = 0;
+  const auto max_depth =
+      std::min(graph_view_->get_max_depth() - get_color_depth_span(color),
+               graph_view_->get_depth());
+  for (auto depth = graph_view_->get_min_depth(); depth <= max_depth;
+       depth++) {
+    edges_count +=
+        graph_view_->graph_->get_depth_color_edges_count(depth, color);
+  }
+  return edges_count;
+}
+
+GraphView::GraphView(const Graph& graph,
+                     GraphView::Depth min_depth,
+                     GraphView::Depth max_depth)
+    : graph_(&graph), min_depth_(min_depth), max_depth_(max_depth) {
+  if (min_depth < 0 || min_depth > max_depth) {
+    throw std::invalid_argument("Invalid depth range");
+  }
+  if (!graph.get_indices().depth_buckets) {
+    throw std::logic_error("Depth buckets index is disabled");
+  }
+}
+
+GraphView::Depth GraphView::get_depth() const {
+  return std::min(max_depth_, graph_->get_depth());
+}
+
+size_t GraphView::get_depth_vertices_count(GraphView::Depth depth) const {
+  return is_depth_in_view(depth) ? graph_->get_depth_vertices_count(depth) : 0;
+}
+
+size_t GraphView::get_depth_color_edges_count(
+    GraphView::Depth depth,
+    GraphView::Edge::Color color) const {
+  if (!is_depth_in_view(depth) ||
+      depth + get_color_depth_span(color) > max_depth_) {
+    return 0;
+  }
+  return graph_->get_depth_color_edges_count(depth, color);
+}
+
+Span<const GraphView::VertexId> GraphView::get_depth_vertex_ids(
+    GraphView::Depth depth) const {
+  if (!is_depth_in_view(depth)) {
+    return {};
+  }
+  return graph_->get_depth_vertex_ids(depth);
+}
+
+bool GraphView::contains_vertex(GraphView::VertexId vertex_id) const {
+  return vertex_id < graph_->get_vertices().size() &&
+         is_depth_in_view(graph_->get_vertex_depth(vertex_id));
+}
+
+GraphView::ConnectedEdgeIds GraphView::get_connected_edge_ids(
+    GraphView::VertexId vertex_id) const {
+  return views::filter(contains_vertex(vertex_id)
+                           ? graph_->get_connected_edge_ids(vertex_id)
+                           : Graph::ConnectedEdgeIds(),
+                       EdgeFilter(*graph_, min_depth_, max_depth_));
+}
+
+bool GraphView::is_vertices_connected(
+    GraphView::VertexId first_vertex_id,
+    GraphView::VertexId second_vertex_id) const {
+  return contains_vertex(first_vertex_id) &&
+         contains_vertex(second_vertex_id) &&
+         graph_->is_vertices_connected(first_vertex_id, second_vertex_id);
+}
+
+GraphView::Depth GraphView::get_vertex_depth(
+    GraphView::VertexId vertex_id) const {
+  return graph_->get_vertex_depth(vertex_id);
+}
+
+GraphView::Vertices GraphView::get_vertices() const {
+  const auto end_depth = get_depth() + 1;
+  return Vertices(*graph_, std::min(min_depth_, end_depth), end_depth);
+}
+}  // namespace uni_course_cpp
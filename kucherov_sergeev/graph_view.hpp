@@ -0,0 +1,230 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+
+#include "graph.hpp"
+#include "span.hpp"
+#include "views.hpp"
+
+namespace uni_course_cpp {
+// Read-only slice of a Graph: the vertices with depths in
+// [min_depth, max_depth] and the edges between them. The view stores no
+// more than the graph pointer and the range, so slicing is O(1); vertices
+// come from the depth buckets and adjacency is filtered while iterated.
+// Ids, depths and properties are those of the graph, which has to outlive
+// the view and whose later inserts the view sees.
+class GraphView {
+ public:
+  using VertexId = Graph::VertexId;
+  using EdgeId = Graph::EdgeId;
+  using Depth = Graph::Depth;
+  using Vertex = Graph::Vertex;
+  using Edge = Graph::Edge;
+
+  // Vertices of the view, depth by depth in depth bucket order.
+  class Vertices {
+   public:
+    class Iterator {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = Vertex;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = Vertex;
+
+      Iterator(const Graph& graph, Depth depth, Depth end_depth)
+          : graph_(&graph), depth_(depth), end_depth_(end_depth) {
+        skip_empty_depths();
+      }
+
+      Vertex operator*() const { return Vertex(get_vertex_id()); }
+      VertexId get_vertex_id() const {
+        return graph_->get_depth_vertex_ids(depth_)[index_];
+      }
+      Iterator& operator++() {
+        index_++;
+        skip_empty_depths();
+        return *this;
+      }
+      bool operator==(const Iterator& other) const {
+        return depth_ == other.depth_ && index_ == other.index_;
+      }
+      bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+     private:
+      void skip_empty_depths();
+
+      const Graph* graph_ = nullptr;
+      Depth depth_ = 0;
+      Depth end_depth_ = 0;
+      size_t index_ = 0;
+    };
+
+    Vertices(const Graph& graph, Depth begin_depth, Depth end_depth)
+        : graph_(&graph), begin_depth_(begin_depth), end_depth_(end_depth) {}
+
+    Iterator begin() const {
+      return Iterator(*graph_, begin_depth_, end_depth_);
+    }
+    Iterator end() const { return Iterator(*graph_, end_depth_, end_depth_); }
+    // Sums the depth bucket sizes, O(depths).
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+
+   private:
+    const Graph* graph_ = nullptr;
+    // Depths [begin_depth_, end_depth_), clamped to the graph depth.
+    Depth begin_depth_ = 0;
+    Depth end_depth_ = 0;
+  };
+
+  // Accepts the edges of the view among the edge ids of a graph.
+  class EdgeFilter {
+   public:
+    EdgeFilter(const Graph& graph, Depth min_depth, Depth max_depth)
+        : graph_(&graph), min_depth_(min_depth), max_depth_(max_depth) {}
+
+    bool operator()(EdgeId edge_id) const;
+
+   private:
+    const Graph* graph_ = nullptr;
+    Depth min_depth_ = 0;
+    Depth max_depth_ = 0;
+  };
+
+  using ConnectedEdgeIds =
+      views::FilterView<Graph::ConnectedEdgeIds, EdgeFilter>;
+
+  // Edges of the view, found through the vertices of the view: every edge
+  // is listed at its source vertex, so the scan never leaves the slice.
+  // Removed edges are skipped, like Graph::EdgeTable does.
+  class EdgeTable {
+   public:
+    class Iterator {
+     public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = Edge;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = Edge;
+
+      Iterator(const GraphView& graph_view, Vertices::Iterator vertex);
+
+      Edge operator*() const {
+        return graph_view_->graph_->get_edges()[*edge_id_];
+      }
+      Iterator& operator++() {
+        ++edge_id_;
+        skip_rejected_edges();
+        return *this;
+      }
+      bool operator==(const Iterator& other) const {
+        return vertex_ == other.vertex_ && edge_id_ == other.edge_id_;
+      }
+      bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+     private:
+      // Moves to the next edge whose source is the current vertex and whose
+      // target is in the view, going on to the next vertices if needed.
+      void skip_rejected_edges();
+      void load_vertex_edges();
+
+      const GraphView* graph_view_ = nullptr;
+      Vertices::Iterator vertex_;
+      Vertices::Iterator end_vertex_;
+      Graph::ConnectedEdgeIds::Iterator edge_id_;
+      Graph::ConnectedEdgeIds::Iterator end_edge_id_;
+    };
+
+    explicit EdgeTable(const GraphView& graph_view)
+        : graph_view_(&graph_view) {}
+
+    Iterator begin() const {
+      return Iterator(*graph_view_, graph_view_->get_vertices().begin());
+    }
+    Iterator end() const {
+      return Iterator(*graph_view_, graph_view_->get_vertices().end());
+    }
+
+    // Counters are summed over the depths of the view, O(depths).
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+    size_t count_color(Edge::Color color) const;
+
+    Edge operator[](EdgeId edge_id) const {
+      return graph_view_->graph_->get_edges()[edge_id];
+    }
+    VertexId from_vertex_id(EdgeId edge_id) const {
+      return graph_view_->graph_->get_edges().from_vertex_id(edge_id);
+    }
+    VertexId to_vertex_id(EdgeId edge_id) const {
+      return graph_view_->graph_->get_edges().to_vertex_id(edge_id);
+    }
+    Edge::Color color(EdgeId edge_id) const {
+      return graph_view_->graph_->get_edges().color(edge_id);
+    }
+
+   private:
+    const GraphView* graph_view_ = nullptr;
+  };
+
+  // Throws std::invalid_argument on a range that is empty or starts below
+  // zero, and std::logic_error if the graph has no depth buckets index.
+  GraphView(const Graph& graph, Depth min_depth, Depth max_depth);
+
+  const Graph& get_graph() const { return *graph_; }
+  Depth get_min_depth() const { return min_depth_; }
+  Depth get_max_depth() const { return max_depth_; }
+
+  // Depths are those of the graph, so depths below the view are empty.
+  Depth get_depth() const;
+
+  size_t get_depth_vertices_count(Depth depth) const;
+  // Edges of the view, counted at the depth of their source vertex.
+  size_t get_depth_color_edges_count(Depth depth, Edge::Color color) const;
+
+  Span<const VertexId> get_depth_vertex_ids(Depth depth) const;
+
+  bool contains_vertex(VertexId vertex_id) const;
+
+  // Empty for vertices outside of the view.
+  ConnectedEdgeIds get_connected_edge_ids(VertexId vertex_id) const;
+
+  bool is_vertices_connected(VertexId first_vertex_id,
+                             VertexId second_vertex_id) const;
+
+  Depth get_vertex_depth(VertexId vertex_id) const;
+
+  Vertices get_vertices() const;
+
+  // Refers to the view, so it is only valid as long as the view is.
+  EdgeTable get_edges() const { return EdgeTable(*this); }
+
+  // Property columns of the graph, indexed by the same ids.
+  template <typename T>
+  const PropertyMap<T>& get_vertex_property(const std::string& name) const {
+    return graph_->get_vertex_property<T>(name);
+  }
+  const PropertyMaps& get_vertex_properties() const {
+    return graph_->get_vertex_properties();
+  }
+  template <typename T>
+  const PropertyMap<T>& get_edge_property(const std::string& name) const {
+    return graph_->get_edge_property<T>(name);
+  }
+  const PropertyMaps& get_edge_properties() const {
+    return graph_->get_edge_properties();
+  }
+
+ private:
+  bool is_depth_in_view(Depth depth) const {
+    return depth >= min_depth_ && depth <= max_depth_;
+  }
+
+  const Graph* graph_ = nullptr;
+  Depth min_depth_ = 0;
+  Depth max_depth_ = 0;
+};
+}  // namespace uni_course_cpp
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "graph.hpp"
+#include "views.hpp"
+
+namespace uni_course_cpp {
+namespace views {
+// Lazy query views over a Graph, a FrozenGraph or a GraphView, which has to
+// outlive them. Vertices of a depth need no view of their own:
+// get_depth_vertex_ids() already returns a non-owning range.
+
+// Vertices of the next depth that are not connected to the given one yet,
+// the possible targets of a yellow edge.
+template <typename GraphType>
+auto unconnected_vertex_ids(const GraphType& graph,
+                            Graph::VertexId vertex_id) {
+  return filter(
+      graph.get_depth_vertex_ids(graph.get_vertex_depth(vertex_id) + 1),
+      [&graph, vertex_id](Graph::VertexId next_depth_vertex_id) {
+        return !graph.is_vertices_connected(vertex_id, next_depth_vertex_id);
+      });
+}
+}  // namespace views
+}  // namespace uni_course_cpp
@@ -0,0 +1,126 @@
+#include <sys/mman.h>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <string>
+
+#include "huge_page_memory_resource.hpp"
+
+namespace uni_course_cpp {
+namespace {
+constexpr const char* kTransparentHugePagesSettingPath =
+    "/sys/kernel/mm/transparent_hugepage/enabled";
+constexpr auto kHugePageSize = HugePageMemoryResource::kHugePageSize;
+
+size_t round_up_to_huge_pages(size_t bytes) {
+  return (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+}
+
+// mmap only promises page alignment, so one extra huge page is mapped and
+// the misaligned head and tail are unmapped.
+void* map_aligned(size_t bytes) {
+  auto* mapping = mmap(nullptr, bytes + kHugePageSize, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapping == MAP_FAILED) {
+    return nullptr;
+  }
+
+  const auto address = reinterpret_cast<uintptr_t>(mapping);
+  const auto aligned_address =
+      (address + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+  const auto head_bytes = aligned_address - address;
+  if (head_bytes != 0) {
+    munmap(mapping, head_bytes);
+  }
+  const auto tail_bytes = kHugePageSize - head_bytes;
+  if (tail_bytes != 0) {
+    munmap(reinterpret_cast<void*>(aligned_address + bytes), tail_bytes);
+  }
+
+  return reinterpret_cast<void*>(aligned_address);
+}
+
+bool advise_huge_pages(void* pointer, size_t bytes) {
+#ifdef MADV_HUGEPAGE
+  return madvise(pointer, bytes, MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif
+}
+
+// Missing setting means the kernel has no transparent huge pages at all.
+bool is_huge_pages_setting_enabled() {
+  auto setting_file = std::ifstream(kTransparentHugePagesSettingPath);
+  auto setting = std::string();
+  if (!std::getline(setting_file, setting)) {
+    return false;
+  }
+
+  return setting.find("[never]") == std::string::npos;
+}
+
+HugePageMemoryResource::Mode detect_mode() {
+  if (!is_huge_pages_setting_enabled()) {
+    return HugePageMemoryResource::Mode::RegularPages;
+  }
+
+  auto* probe = map_aligned(kHugePageSize);
+  if (probe == nullptr) {
+    return HugePageMemoryResource::Mode::RegularPages;
+  }
+  const auto is_advised = advise_huge_pages(probe, kHugePageSize);
+  munmap(probe, kHugePageSize);
+
+  return is_advised ? HugePageMemoryResource::Mode::HugePages
+                    : HugePageMemoryResource::Mode::RegularPages;
+}
+}  // namespace
+
+HugePageMemoryResource::HugePageMemoryResource(
+    std::pmr::memory_resource* upstream)
+    : upstream_(upstream), mode_(detect_mode()) {}
+
+void* HugePageMemoryResource::do_allocate(size_t bytes, size_t alignment) {
+  if (!is_mapped(bytes, alignment)) {
+    return upstream_->allocate(bytes, alignment);
+  }
+
+  const auto mapped_bytes = round_up_to_huge_pages(bytes);
+  auto* pointer = map_aligned(mapped_bytes);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  // The probe succeeded, so a failure here only leaves this mapping on
+  // regular pages.
+  advise_huge_pages(pointer, mapped_bytes);
+
+  return pointer;
+}
+
+void HugePageMemoryResource::do_deallocate(void* pointer,
+                                           size_t bytes,
+                                           size_t alignment) {
+  if (!is_mapped(bytes, alignment)) {
+    upstream_->deallocate(pointer, bytes, alignment);
+    return;
+  }
+
+  munmap(pointer, round_up_to_huge_pages(bytes));
+}
+
+bool HugePageMemoryResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+bool HugePageMemoryResource::is_mapped(size_t bytes, size_t alignment) const {
+  return mode_ == Mode::HugePages && bytes >= kHugePageSize &&
+         alignment <= kHugePageSize;
+}
+
+HugePageMemoryResource* get_huge_page_memory_resource() {
+  static auto memory_resource = HugePageMemoryResource();
+
+  return &memory_resource;
+}
+}  // namespace uni_course_cpp
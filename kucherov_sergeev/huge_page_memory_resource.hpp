@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace uni_course_cpp {
+// Memory resource for large graph arrays. Allocations of at least one huge
+// page are mapped separately, aligned to the huge page size and advised to be
+// backed by transparent huge pages, which cuts TLB misses on random accesses.
+// Smaller allocations go to the upstream resource. When huge pages are not
+// available, everything goes upstream. Thread safe if the upstream is.
+class HugePageMemoryResource : public std::pmr::memory_resource {
+ public:
+  enum class Mode { HugePages, RegularPages };
+
+  static constexpr size_t kHugePageSize = size_t(2) << 20;
+
+  // The mode is detected once, by mapping and advising a probe page.
+  HugePageMemoryResource()
+      : HugePageMemoryResource(std::pmr::get_default_resource()) {}
+  explicit HugePageMemoryResource(std::pmr::memory_resource* upstream);
+
+  HugePageMemoryResource(const HugePageMemoryResource& other) = delete;
+  HugePageMemoryResource& operator=(const HugePageMemoryResource& other) =
+      delete;
+
+  Mode get_mode() const { return mode_; }
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource& other) const
+      noexcept override;
+
+  bool is_mapped(size_t bytes, size_t alignment) const;
+
+  std::pmr::memory_resource* upstream_ = nullptr;
+  Mode mode_ = Mode::RegularPages;
+};
+
+// Process wide instance over the default resource, similar to
+// std::pmr::new_delete_resource().
+HugePageMemoryResource* get_huge_page_memory_resource();
+}  // namespace uni_course_cpp
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+
+namespace uni_course_cpp {
+// Half-open range [begin, end) of consecutive ids, iterated without storage.
+template <typename Id>
+class IdRange {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Id;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Id*;
+    using reference = Id;
+
+    explicit Iterator(Id id) : id_(id) {}
+
+    Id operator*() const { return id_; }
+    Iterator& operator++() {
+      id_++;
+      return *this;
+    }
+    bool operator==(const Iterator& other) const { return id_ == other.id_; }
+    bool operator!=(const Iterator& other) const { return id_ != other.id_; }
+
+   private:
+    Id id_ = 0;
+  };
+
+  IdRange() = default;
+  IdRange(Id begin, Id end) : begin_(begin), end_(end) {}
+
+  Iterator begin() const { return Iterator(begin_); }
+  Iterator end() const { return Iterator(end_); }
+  size_t size() const { return end_ - begin_; }
+  bool empty() const { return begin_ == end_; }
+
+  Id operator[](size_t index) const {
+    assert(index < size() && "IdRange index is out of range");
+    return begin_ + index;
+  }
+
+ private:
+  Id begin_ = 0;
+  Id end_ = 0;
+};
+}  // namespace uni_course_cpp
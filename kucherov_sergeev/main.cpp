@@ -7,21 +7,55 @@
 #include "graph.hpp"
 #include "graph_generation_controller.hpp"
 #include "graph_generator.hpp"
+#include "graph_handle.hpp"
 #include "graph_json_printing.hpp"
 #include "graph_printing.hpp"
+#include "huge_page_memory_resource.hpp"
 #include "logger.hpp"
 
 using Graph = uni_course_cpp::Graph;
 using GraphGenerator = uni_course_cpp::GraphGenerator;
+using GraphHandle = uni_course_cpp::GraphHandle;
 using Logger = uni_course_cpp::Logger;
 
-void write_to_file(const std::string& graph_json,
-                   const std::string& file_name) {
+// Usage: run [--huge-pages] [--spill-edges]
+//   --huge-pages   backs the arenas of generated graphs with transparent huge
+//                  pages, see GraphGenerator::AllocationMode.
+//   --spill-edges  keeps the per-edge storage of generated graphs in memory
+//                  mapped segment files, see GraphGenerator::SpillMode.
+static constexpr const char* kHugePagesFlag = "--huge-pages";
+static constexpr const char* kSpillEdgesFlag = "--spill-edges";
+
+struct Arguments {
+  GraphGenerator::AllocationMode allocation_mode =
+      GraphGenerator::AllocationMode::Default;
+  GraphGenerator::SpillMode spill_mode = GraphGenerator::SpillMode::Off;
+};
+
+void write_to_file(const Graph& graph, const std::string& file_name) {
   const std::string file_path =
       uni_course_cpp::config::kTempDirectoryPath + file_name;
   std::ofstream json_file(file_path);
 
-  json_file << graph_json;
+  uni_course_cpp::printing::json::print_graph(json_file, graph);
+}
+
+Arguments handle_arguments(int argc, char** argv) {
+  auto arguments = Arguments();
+  for (int i = 1; i < argc; i++) {
+    const auto argument = std::string(argv[i]);
+    if (argument == kHugePagesFlag) {
+      arguments.allocation_mode = GraphGenerator::AllocationMode::HugePages;
+    } else if (argument == kSpillEdgesFlag) {
+      arguments.spill_mode = GraphGenerator::SpillMode::EdgesToDisk;
+    } else {
+      throw std::invalid_argument("Unknown argument " + argument +
+                                  ", usage: run [" + kHugePagesFlag + "] [" +
+                                  kSpillEdgesFlag + "]");
+    }
+  }
+
+  return arguments;
 }
 
 int handle_depth_input() {
@@ -131,6 +165,12 @@ std::string generation_finished_string(int graph_number,
          graph_description;
 }
 
+std::string memory_usage_string(int graph_number,
+                                const std::string& memory_usage_description) {
+  return "Graph " + std::to_string(graph_number) + ", Memory Usage " +
+         memory_usage_description;
+}
+
 void prepare_temp_directory() {
   if (std::filesystem::exists(uni_course_cpp::config::kTempDirectoryPath) ==
       false) {
@@ -141,40 +181,53 @@ void prepare_temp_directory() {
   }
 }
 
-std::vector<Graph> generate_graphs(GraphGenerator::Params&& params,
-                                   int graphs_count,
-                                   int threads_count) {
+std::vector<GraphHandle> generate_graphs(GraphGenerator::Params&& params,
+                                         int graphs_count,
+                                         int threads_count) {
   auto generation_controller = uni_course_cpp::GraphGenerationController(
       threads_count, graphs_count, std::move(params));
 
   auto& logger = Logger::get_logger();
 
-  auto graphs = std::vector<Graph>();
+  auto graphs = std::vector<GraphHandle>();
   graphs.reserve(graphs_count);
 
+  // Graphs are shared with the collection, not copied, so the callback
+  // mutex is held only while printing.
   generation_controller.generate(
       [&logger](int index) { logger.log(generation_started_string(index)); },
-      [&logger, &graphs](int index, Graph&& graph) {
-        graphs.push_back(graph);
+      [&logger, &graphs](int index, GraphHandle graph) {
         const auto graph_description =
-            uni_course_cpp::printing::print_graph(graph);
+            uni_course_cpp::printing::print_graph(*graph);
         logger.log(generation_finished_string(index, graph_description));
-        const auto graph_json =
-            uni_course_cpp::printing::json::print_graph(graph);
-        write_to_file(graph_json, "graph_" + std::to_string(index) + ".json");
+        logger.log(memory_usage_string(
+            index, uni_course_cpp::printing::print_memory_usage(
+                       graph->memory_usage())));
+        write_to_file(*graph, "graph_" + std::to_string(index) + ".json");
+        graphs.push_back(std::move(graph));
       });
 
   return graphs;
 }
 
-int main() {
+int main(int argc, char** argv) {
+  const auto arguments = handle_arguments(argc, argv);
   const int depth = handle_depth_input();
   const int new_vertices_count = handle_new_vertices_count_input();
   const int graphs_count = handle_graphs_count_input();
   const int threads_count = handle_threads_count_input();
   prepare_temp_directory();
 
-  auto params = GraphGenerator::Params(depth, new_vertices_count);
+  if (arguments.allocation_mode == GraphGenerator::AllocationMode::HugePages) {
+    Logger::get_logger().log(
+        "Memory Mode: " +
+        uni_course_cpp::printing::print_memory_mode(
+            uni_course_cpp::get_huge_page_memory_resource()->get_mode()));
+  }
+
+  auto params = GraphGenerator::Params(depth, new_vertices_count,
+                                       arguments.allocation_mode,
+                                       arguments.spill_mode);
 
   const auto graphs =
       generate_graphs(std::move(params), graphs_count, threads_count);
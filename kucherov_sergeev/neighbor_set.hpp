@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <unordered_set>
+#include <utility>
+
+namespace uni_course_cpp {
+// Set of neighbor vertex ids of a single vertex. Low degree vertices keep
+// their neighbors in a small sorted inline array; once it overflows, the set
+// switches to a hash set, so membership tests stay O(log d) or O(1).
+template <typename VertexId>
+class NeighborSet {
+ public:
+  using allocator_type = std::pmr::polymorphic_allocator<VertexId>;
+
+  static constexpr int kInlineCapacity = 6;
+
+  NeighborSet() = default;
+
+  explicit NeighborSet(const allocator_type& allocator)
+      : allocator_(allocator) {}
+
+  NeighborSet(const NeighborSet& other, const allocator_type& allocator)
+      : inline_vertex_ids_(other.inline_vertex_ids_),
+        inline_size_(other.inline_size_),
+        allocator_(allocator) {
+    if (other.hub_vertex_ids_ != nullptr) {
+      create_hub_vertex_ids(other.hub_vertex_ids_->begin(),
+                            other.hub_vertex_ids_->end());
+    }
+  }
+
+  NeighborSet(const NeighborSet& other)
+      : NeighborSet(other, allocator_type()) {}
+
+  NeighborSet(NeighborSet&& other, const allocator_type& allocator)
+      : NeighborSet(allocator) {
+    if (allocator_ == other.allocator_) {
+      swap(other);
+    } else {
+      *this = other;
+    }
+  }
+
+  NeighborSet(NeighborSet&& other) noexcept : allocator_(other.allocator_) {
+    swap(other);
+  }
+
+  // Assignment keeps the allocator of the assigned-to set, like the
+  // polymorphic allocator aware standard containers do.
+  NeighborSet& operator=(const NeighborSet& other) {
+    if (this != &other) {
+      auto copy = NeighborSet(other, allocator_);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  NeighborSet& operator=(NeighborSet&& other) {
+    if (allocator_ == other.allocator_) {
+      swap(other);
+    } else {
+      *this = other;
+    }
+    return *this;
+  }
+
+  ~NeighborSet() { destroy_hub_vertex_ids(); }
+
+  bool contains(VertexId vertex_id) const {
+    if (hub_vertex_ids_ != nullptr) {
+      return hub_vertex_ids_->count(vertex_id) != 0;
+    }
+
+    const auto inline_end = inline_vertex_ids_.begin() + inline_size_;
+    return std::binary_search(inline_vertex_ids_.begin(), inline_end,
+                              vertex_id);
+  }
+
+  void insert(VertexId vertex_id) {
+    if (hub_vertex_ids_ != nullptr) {
+      hub_vertex_ids_->insert(vertex_id);
+      return;
+    }
+
+    const auto inline_end = inline_vertex_ids_.begin() + inline_size_;
+    const auto position =
+        std::lower_bound(inline_vertex_ids_.begin(), inline_end, vertex_id);
+    if (position != inline_end && *position == vertex_id) {
+      return;
+    }
+
+    if (inline_size_ < kInlineCapacity) {
+      std::move_backward(position, inline_end, inline_end + 1);
+      *position = vertex_id;
+      inline_size_++;
+      return;
+    }
+
+    create_hub_vertex_ids(inline_vertex_ids_.begin(), inline_end);
+    hub_vertex_ids_->insert(vertex_id);
+    inline_size_ = 0;
+  }
+
+  size_t size() const {
+    return hub_vertex_ids_ != nullptr ? hub_vertex_ids_->size() : inline_size_;
+  }
+
+  // Bytes allocated outside of the set object. Hash set nodes are estimated
+  // as a next pointer plus the id, rounded up to the allocation alignment.
+  size_t allocated_bytes() const {
+    if (hub_vertex_ids_ == nullptr) {
+      return 0;
+    }
+
+    constexpr size_t kAlignment = alignof(std::max_align_t);
+    constexpr size_t kHubNodeBytes =
+        (sizeof(void*) + sizeof(VertexId) + kAlignment - 1) / kAlignment *
+        kAlignment;
+    return sizeof(HubVertexIds) +
+           hub_vertex_ids_->bucket_count() * sizeof(void*) +
+           hub_vertex_ids_->size() * kHubNodeBytes;
+  }
+
+ private:
+  using HubVertexIds = std::pmr::unordered_set<VertexId>;
+
+  template <typename Iterator>
+  void create_hub_vertex_ids(Iterator begin, Iterator end) {
+    auto hub_allocator =
+        std::pmr::polymorphic_allocator<HubVertexIds>(allocator_.resource());
+    hub_vertex_ids_ = hub_allocator.allocate(1);
+    hub_allocator.construct(hub_vertex_ids_, begin, end,
+                            2 * kInlineCapacity);
+  }
+
+  void destroy_hub_vertex_ids() {
+    if (hub_vertex_ids_ == nullptr) {
+      return;
+    }
+
+    auto hub_allocator =
+        std::pmr::polymorphic_allocator<HubVertexIds>(allocator_.resource());
+    hub_allocator.destroy(hub_vertex_ids_);
+    hub_allocator.deallocate(hub_vertex_ids_, 1);
+    hub_vertex_ids_ = nullptr;
+  }
+
+  void swap(NeighborSet& other) {
+    std::swap(inline_vertex_ids_, other.inline_vertex_ids_);
+    std::swap(inline_size_, other.inline_size_);
+    std::swap(hub_vertex_ids_, other.hub_vertex_ids_);
+  }
+
+  std::array<VertexId, kInlineCapacity> inline_vertex_ids_ = {};
+  uint8_t inline_size_ = 0;
+  HubVertexIds* hub_vertex_ids_ = nullptr;
+  allocator_type allocator_;
+};
+}  // namespace uni_course_cpp
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace uni_course_cpp {
+// Number of ranges parallel_for() splits the items into: one per hardware
+// thread, but none shorter than min_items_per_range.
+inline size_t get_parallel_ranges_count(size_t items_count,
+                                        size_t min_items_per_range) {
+  return std::max<size_t>(
+      std::min<size_t>(std::thread::hardware_concurrency(),
+                       items_count / min_items_per_range),
+      1);
+}
+
+// Splits [0, items_count) into contiguous ranges and runs
+// job(range, begin, end) on every range at once, the first one on the
+// calling thread. The split only depends on the arguments, so consecutive
+// calls with the same ones see the same ranges.
+template <typename Job>
+void parallel_for(size_t items_count,
+                  size_t min_items_per_range,
+                  const Job& job) {
+  const auto ranges_count =
+      get_parallel_ranges_count(items_count, min_items_per_range);
+  const auto run_range = [items_count, ranges_count, &job](size_t range) {
+    job(range, items_count * range / ranges_count,
+        items_count * (range + 1) / ranges_count);
+  };
+
+  auto threads = std::vector<std::thread>();
+  threads.reserve(ranges_count - 1);
+  for (size_t range = 1; range < ranges_count; range++) {
+    threads.emplace_back(run_range, range);
+  }
+  run_range(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+}  // namespace uni_course_cpp
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "span.hpp"
+
+namespace uni_course_cpp {
+// Column of a vertex or edge attribute, indexed densely by id. Storage grows
+// up to the largest id set so far, ids past its end read as the default
+// value, so a property costs nothing until values are set.
+template <typename T>
+class PropertyMap {
+ public:
+  using value_type = T;
+
+  // New id that makes relabel() drop the value.
+  static constexpr size_t kDroppedId = std::numeric_limits<size_t>::max();
+
+  PropertyMap(T default_value, std::pmr::memory_resource* memory_resource)
+      : default_value_(std::move(default_value)), values_(memory_resource) {}
+  // Copies the column into storage from the given memory resource.
+  PropertyMap(const PropertyMap& other,
+              std::pmr::memory_resource* memory_resource)
+      : default_value_(other.default_value_),
+        values_(other.values_, memory_resource) {}
+
+  const T& operator[](size_t id) const {
+    return id < values_.size() ? values_[id] : default_value_;
+  }
+
+  void set(size_t id, T value) {
+    if (id >= values_.size()) {
+      values_.resize(id + 1, default_value_);
+    }
+    values_[id] = std::move(value);
+  }
+
+  const T& get_default_value() const { return default_value_; }
+
+  // Contiguous values of ids below size(), for scans over the column.
+  Span<const T> get_values() const { return values_; }
+  size_t size() const { return values_.size(); }
+
+  size_t memory_usage() const { return values_.capacity() * sizeof(T); }
+
+  // Moves the value of every id to new_id(id), or drops it if that is
+  // kDroppedId.
+  template <typename NewId>
+  void relabel(NewId new_id) {
+    auto values = std::pmr::vector<T>(values_.get_allocator());
+    for (size_t id = 0; id < values_.size(); id++) {
+      const auto relabeled_id = static_cast<size_t>(new_id(id));
+      if (relabeled_id == kDroppedId) {
+        continue;
+      }
+      if (relabeled_id >= values.size()) {
+        values.resize(relabeled_id + 1, default_value_);
+      }
+      values[relabeled_id] = std::move(values_[id]);
+    }
+    values_ = std::move(values);
+  }
+
+ private:
+  T default_value_;
+  std::pmr::vector<T> values_;
+};
+
+// Property of one of the supported value types.
+using PropertyColumn = std::variant<PropertyMap<int64_t>,
+                                    PropertyMap<double>,
+                                    PropertyMap<std::string>>;
+// Properties by name, in the order they are serialized.
+using PropertyMaps = std::map<std::string, PropertyColumn>;
+
+template <typename T>
+PropertyMap<T>& add_property(PropertyMaps& properties,
+                             const std::string& name,
+                             T default_value,
+                             std::pmr::memory_resource* memory_resource) {
+  const auto [iterator, is_inserted] = properties.try_emplace(
+      name, std::in_place_type<PropertyMap<T>>, std::move(default_value),
+      memory_resource);
+  if (!is_inserted) {
+    throw std::invalid_argument("Property " + name + " already exists");
+  }
+  return std::get<PropertyMap<T>>(iterator->second);
+}
+
+// Copies every column into storage from the given memory resource, where
+// copying the map would put them on the default one.
+inline PropertyMaps copy_properties(
+    const PropertyMaps& properties,
+    std::pmr::memory_resource* memory_resource) {
+  auto copied_properties = PropertyMaps();
+  for (const auto& [name, property] : properties) {
+    copied_properties.emplace(
+        name, std::visit(
+                  [memory_resource](const auto& property_map) {
+                    using PropertyMapType =
+                        std::decay_t<decltype(property_map)>;
+                    return PropertyColumn(
+                        PropertyMapType(property_map, memory_resource));
+                  },
+                  property));
+  }
+  return copied_properties;
+}
+
+template <typename T>
+const PropertyMap<T>& get_property(const PropertyMaps& properties,
+                                   const std::string& name) {
+  const auto iterator = properties.find(name);
+  if (iterator == properties.end()) {
+    throw std::out_of_range("Property " + name + " does not exist");
+  }
+  const auto* property = std::get_if<PropertyMap<T>>(&iterator->second);
+  if (property == nullptr) {
+    throw std::logic_error("Property " + name + " has another type");
+  }
+  return *property;
+}
+
+template <typename T>
+PropertyMap<T>& get_property(PropertyMaps& properties,
+                             const std::string& name) {
+  return const_cast<PropertyMap<T>&>(
+      get_property<T>(std::as_const(properties), name));
+}
+}  // namespace uni_course_cpp
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace uni_course_cpp {
+// Array of default constructed elements that grows on first access to an
+// index and never moves its elements. Storage comes in blocks, each twice
+// the size of the previous one, so a fixed table of block pointers covers
+// any index. Many threads may access it at once: a missing block is
+// allocated by whoever needs it first, and synchronizing on the elements
+// themselves is up to the caller.
+template <typename T>
+class SegmentedArray {
+ public:
+  SegmentedArray() = default;
+
+  SegmentedArray(const SegmentedArray& other) = delete;
+  SegmentedArray& operator=(const SegmentedArray& other) = delete;
+
+  ~SegmentedArray() {
+    for (auto& block : blocks_) {
+      delete[] block.load(std::memory_order_relaxed);
+    }
+  }
+
+  T& operator[](size_t index) {
+    const auto block_index = get_block_index(index);
+    auto* block = blocks_[block_index].load(std::memory_order_acquire);
+    if (block == nullptr) {
+      block = allocate_block(block_index);
+    }
+    return block[index - get_block_begin(block_index)];
+  }
+
+  // The element's block must exist, that is the index was accessed through
+  // the non-const operator before.
+  const T& operator[](size_t index) const {
+    const auto block_index = get_block_index(index);
+    return blocks_[block_index].load(std::memory_order_acquire)
+        [index - get_block_begin(block_index)];
+  }
+
+ private:
+  static constexpr size_t kFirstBlockSize = 1024;
+  static constexpr size_t kBlocksCount = 48;
+
+  static size_t get_block_index(size_t index) {
+    const auto blocks_position = index / kFirstBlockSize + 1;
+    size_t block_index = 0;
+    while ((blocks_position >> (block_index + 1)) != 0) {
+      block_index++;
+    }
+    return block_index;
+  }
+
+  static size_t get_block_begin(size_t block_index) {
+    return kFirstBlockSize * ((size_t(1) << block_index) - 1);
+  }
+
+  T* allocate_block(size_t block_index) {
+    auto* block = new T[kFirstBlockSize << block_index]();
+    T* expected_block = nullptr;
+    if (!blocks_[block_index].compare_exchange_strong(
+            expected_block, block, std::memory_order_acq_rel)) {
+      delete[] block;
+      return expected_block;
+    }
+    return block;
+  }
+
+  std::array<std::atomic<T*>, kBlocksCount> blocks_ = {};
+};
+}  // namespace uni_course_cpp
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace uni_course_cpp {
+// Non-owning view over a contiguous array, a C++17 stand-in for std::span.
+template <typename T>
+class Span {
+ public:
+  using value_type = std::remove_cv_t<T>;
+  using iterator = T*;
+
+  Span() = default;
+  Span(T* data, size_t size) : data_(data), size_(size) {}
+  Span(T* begin, T* end) : data_(begin), size_(end - begin) {}
+
+  // Only for elements that T can view as they are, like std::span.
+  template <typename U,
+            typename Allocator,
+            typename =
+                std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+  Span(const std::vector<U, Allocator>& vector)
+      : data_(vector.data()), size_(vector.size()) {}
+
+  T* begin() const { return data_; }
+  T* end() const { return data_ + size_; }
+  T* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  T& operator[](size_t index) const {
+    assert(index < size_ && "Span index is out of range");
+    return data_[index];
+  }
+
+ private:
+  T* data_ = nullptr;
+  size_t size_ = 0;
+};
+}  // namespace uni_course_cpp
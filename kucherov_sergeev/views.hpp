@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace uni_course_cpp {
+namespace views {
+// Lazy C++17 stand-in for std::views::filter. The view holds the adapted
+// range by value, so ranges that are views themselves, like Span, IdRange
+// or Graph::ConnectedEdgeIds, compose without allocating.
+
+template <typename Range, typename Predicate>
+class FilterView {
+ public:
+  using BaseIterator = decltype(std::declval<const Range&>().begin());
+
+  class Iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = typename std::iterator_traits<BaseIterator>::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = decltype(*std::declval<BaseIterator>());
+
+    Iterator(BaseIterator iterator,
+             BaseIterator end,
+             const Predicate* predicate)
+        : iterator_(iterator), end_(end), predicate_(predicate) {
+      skip_rejected();
+    }
+
+    reference operator*() const { return *iterator_; }
+    Iterator& operator++() {
+      ++iterator_;
+      skip_rejected();
+      return *this;
+    }
+    bool operator==(const Iterator& other) const {
+      return iterator_ == other.iterator_;
+    }
+    bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+   private:
+    void skip_rejected() {
+      while (iterator_ != end_ && !(*predicate_)(*iterator_)) {
+        ++iterator_;
+      }
+    }
+
+    BaseIterator iterator_;
+    BaseIterator end_;
+    const Predicate* predicate_ = nullptr;
+  };
+
+  FilterView(Range range, Predicate predicate)
+      : range_(std::move(range)), predicate_(std::move(predicate)) {}
+
+  // Every call walks up to the first accepted element.
+  Iterator begin() const {
+    return Iterator(range_.begin(), range_.end(), &predicate_);
+  }
+  Iterator end() const {
+    return Iterator(range_.end(), range_.end(), &predicate_);
+  }
+  bool empty() const { return begin() == end(); }
+
+ private:
+  Range range_;
+  Predicate predicate_;
+};
+
+template <typename Range, typename Predicate>
+FilterView<Range, Predicate> filter(Range range, Predicate predicate) {
+  return {std::move(range), std::move(predicate)};
+}
+}  // namespace views
+}  // namespace uni_course_cpp
@@ -0,0 +1,134 @@
+// Compares the graph backends on generation and on both printers. It lives
+// apart from the sources of the program, which has a main() of its own, and
+// is built by `make benchmark`.
+// Usage: run_benchmark [depth] [new vertices count] [graphs count]
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../graph_backend.hpp"
+#include "../graph_generator.hpp"
+#include "../graph_json_printing.hpp"
+#include "../interfaces/i_graph.hpp"
+#include "../printing.hpp"
+
+using GraphBackend = uni_course_cpp::GraphBackend;
+using GraphGenerator = uni_course_cpp::GraphGenerator;
+using IGraph = uni_course_cpp::IGraph;
+
+namespace {
+
+constexpr uni_course_cpp::GraphDepth kDefaultDepth = 9;
+constexpr int kDefaultNewVerticesCount = 4;
+constexpr int kDefaultGraphsCount = 5;
+
+double measure_seconds(const std::function<void()>& function) {
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  const auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(finish - start).count();
+}
+
+long get_peak_rss_kibibytes() {
+  auto usage = rusage();
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+void print_result(GraphBackend backend,
+                  const std::string& name,
+                  double amount,
+                  const std::string& unit,
+                  double seconds) {
+  std::cout << uni_course_cpp::printing::print_graph_backend(backend) << ", "
+            << name << ": " << amount / seconds << " " << unit << "/s ("
+            << seconds * 1000 << " ms)" << std::endl;
+}
+
+void benchmark_backend(GraphBackend backend,
+                       uni_course_cpp::GraphDepth depth,
+                       int new_vertices_count,
+                       int graphs_count) {
+  auto graphs = std::vector<std::unique_ptr<IGraph>>();
+  const auto generation_seconds =
+      measure_seconds([backend, depth, new_vertices_count, graphs_count,
+                       &graphs]() {
+        const auto generator = GraphGenerator(
+            GraphGenerator::Params(depth, new_vertices_count, backend));
+        for (int i = 0; i < graphs_count; ++i) {
+          graphs.push_back(generator.generate());
+        }
+      });
+
+  size_t elements_count = 0;
+  for (const auto& graph : graphs) {
+    elements_count += graph->get_vertices().size() + graph->get_edges().size();
+  }
+
+  size_t json_characters_count = 0;
+  const auto json_seconds = measure_seconds([&graphs,
+                                             &json_characters_count]() {
+    for (const auto& graph : graphs) {
+      json_characters_count +=
+          uni_course_cpp::printing::json::print_graph(*graph).size();
+    }
+  });
+
+  size_t summary_characters_count = 0;
+  const auto summary_seconds = measure_seconds([&graphs,
+                                                &summary_characters_count]() {
+    for (const auto& graph : graphs) {
+      summary_characters_count +=
+          uni_course_cpp::printing::print_graph(*graph).size();
+    }
+  });
+
+  print_result(backend, "generation", elements_count, "elements",
+               generation_seconds);
+  print_result(backend, "json printing", json_characters_count / 1e6, "MB",
+               json_seconds);
+  print_result(backend, "summary printing", graphs.size(), "graphs",
+               summary_seconds);
+  std::cout << uni_course_cpp::printing::print_graph_backend(backend)
+            << ", peak RSS: " << get_peak_rss_kibibytes() << " KiB"
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto depth = (argc > 1) ? std::atoi(argv[1]) : kDefaultDepth;
+  const auto new_vertices_count =
+      (argc > 2) ? std::atoi(argv[2]) : kDefaultNewVerticesCount;
+  const auto graphs_count =
+      (argc > 3) ? std::atoi(argv[3]) : kDefaultGraphsCount;
+
+  // Every backend runs in a child process of its own, so that its peak RSS
+  // is not the peak of the backends before it.
+  for (const auto backend :
+       {GraphBackend::HashMap, GraphBackend::FlatVector, GraphBackend::Csr}) {
+    const auto process_id = fork();
+    if (process_id == -1) {
+      std::cerr << "Can't fork a benchmark process" << std::endl;
+      return 1;
+    }
+    if (process_id == 0) {
+      benchmark_backend(backend, depth, new_vertices_count, graphs_count);
+      std::_Exit(0);
+    }
+    waitpid(process_id, nullptr, 0);
+  }
+
+  return 0;
+}
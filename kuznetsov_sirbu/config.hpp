@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include "graph_backend.hpp"
 
 namespace uni_course_cpp {
 
@@ -10,6 +11,8 @@ inline constexpr const char* kLogFilename = "log.txt";
 inline const std::string kLogFilePath =
     static_cast<std::string>(kTempDirectoryPath) +
     static_cast<std::string>(kLogFilename);
+// Used unless the first command line argument names another backend.
+inline constexpr GraphBackend kDefaultGraphBackend = GraphBackend::HashMap;
 
 }  // namespace config
 }  // namespace uni_course_cpp
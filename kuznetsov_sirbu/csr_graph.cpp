@@ -0,0 +1,114 @@
+#include "csr_graph.hpp"
+
+namespace uni_course_cpp {
+
+namespace {
+
+template <typename Id>
+IdSpan<Id> get_slice(const std::vector<Id>& ids,
+                     size_t begin_offset,
+                     size_t end_offset) {
+  return IdSpan<Id>(ids.data() + begin_offset, end_offset - begin_offset);
+}
+
+}  // namespace
+
+CsrGraph::CsrGraph(const IGraph& graph) {
+  const auto vertices = graph.get_vertices();
+  vertices_.reserve(vertices.size());
+  vertex_depths_.reserve(vertices.size());
+  edge_offsets_.reserve(vertices.size() + 1);
+  edge_offsets_.push_back(0);
+  for (const auto& vertex : vertices) {
+    if (vertex.id() != vertices_.size()) {
+      throw std::invalid_argument("Vertex ids of the graph are not dense");
+    }
+    vertices_.emplace_back(vertex.id());
+    vertex_depths_.push_back(graph.vertex_depth(vertex.id()));
+    const auto edge_ids = graph.connected_edges_ids(vertex.id());
+    adjacent_edge_ids_.insert(adjacent_edge_ids_.end(), edge_ids.begin(),
+                              edge_ids.end());
+    edge_offsets_.push_back(adjacent_edge_ids_.size());
+  }
+
+  const auto edges = graph.get_edges();
+  edges_.reserve(edges.size());
+  for (const auto& edge : edges) {
+    if (edge.id() != edges_.size()) {
+      throw std::invalid_argument("Edge ids of the graph are not dense");
+    }
+    edges_.emplace_back(edge.id(), edge.from_vertex_id(), edge.to_vertex_id(),
+                        edge.color());
+  }
+
+  depth_vertex_ids_.reserve(vertices.size());
+  depth_offsets_.push_back(0);
+  for (GraphDepth depth = kGraphBaseDepth;
+       depth < kGraphBaseDepth + graph.depth(); ++depth) {
+    const auto vertex_ids = graph.get_vertices_with_depth(depth);
+    depth_vertex_ids_.insert(depth_vertex_ids_.end(), vertex_ids.begin(),
+                             vertex_ids.end());
+    depth_offsets_.push_back(depth_vertex_ids_.size());
+  }
+
+  color_edge_ids_.reserve(edges.size());
+  for (int color = 0; color < kEdgeColorsCount; ++color) {
+    const auto edge_ids =
+        graph.get_edge_ids_with_color(static_cast<EdgeColor>(color));
+    color_edge_ids_.insert(color_edge_ids_.end(), edge_ids.begin(),
+                           edge_ids.end());
+    color_offsets_[color + 1] = color_edge_ids_.size();
+  }
+}
+
+VertexId CsrGraph::add_vertex() {
+  throw std::logic_error("CsrGraph is read-only");
+}
+
+EdgeId CsrGraph::add_edge(VertexId, VertexId) {
+  throw std::logic_error("CsrGraph is read-only");
+}
+
+void CsrGraph::set_vertex_depth(VertexId, GraphDepth) {
+  throw std::logic_error("CsrGraph is read-only");
+}
+
+IdSpan<EdgeId> CsrGraph::connected_edges_ids(VertexId vertex_id) const {
+  if (!has_vertex(vertex_id)) {
+    return {};
+  }
+  return get_slice(adjacent_edge_ids_, edge_offsets_[vertex_id],
+                   edge_offsets_[vertex_id + 1]);
+}
+
+bool CsrGraph::is_connected(VertexId from_vertex_id,
+                            VertexId to_vertex_id) const {
+  if (!has_vertex(from_vertex_id)) {
+    throw std::out_of_range("Vertex does not exist");
+  }
+  for (const auto edge_id : connected_edges_ids(from_vertex_id)) {
+    const auto& edge = edges_[edge_id];
+    if (edge.from_vertex_id() == to_vertex_id ||
+        edge.to_vertex_id() == to_vertex_id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+IdSpan<VertexId> CsrGraph::get_vertices_with_depth(GraphDepth depth) const {
+  const auto depth_index = depth - kGraphBaseDepth;
+  if (depth_index < 0 || depth_index >= this->depth()) {
+    return {};
+  }
+  return get_slice(depth_vertex_ids_, depth_offsets_[depth_index],
+                   depth_offsets_[depth_index + 1]);
+}
+
+IdSpan<EdgeId> CsrGraph::get_edge_ids_with_color(EdgeColor color) const {
+  const auto color_index = static_cast<int>(color);
+  return get_slice(color_edge_ids_, color_offsets_[color_index],
+                   color_offsets_[color_index + 1]);
+}
+
+}  // namespace uni_course_cpp
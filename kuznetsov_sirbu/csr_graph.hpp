@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <stdexcept>
+#include <vector>
+#include "graph_elements.hpp"
+#include "interfaces/i_graph.hpp"
+
+namespace uni_course_cpp {
+
+// Frozen compressed sparse row backend, built once from a finished graph.
+// Each id index is one array sliced by an offsets array, so the graph takes
+// a handful of allocations and every query reads contiguous memory.
+// Mutators throw std::logic_error.
+class CsrGraph final : public IGraph {
+ public:
+  // Copies the graph, keeping the order of every id list. Throws
+  // std::invalid_argument unless its vertex and edge ids are dense.
+  explicit CsrGraph(const IGraph& graph);
+
+  VertexId add_vertex() override;
+
+  EdgeId add_edge(VertexId from_vertex_id, VertexId to_vertex_id) override;
+
+  bool has_vertex(VertexId vertex_id) const override {
+    return vertex_id < vertices_.size();
+  }
+
+  InterfaceSpan<IVertex> get_vertices() const override {
+    return InterfaceSpan<IVertex>(vertices_);
+  }
+
+  InterfaceSpan<IEdge> get_edges() const override {
+    return InterfaceSpan<IEdge>(edges_);
+  }
+
+  // Same elements as above, as their concrete types.
+  const std::vector<Vertex>& get_vertex_list() const { return vertices_; }
+  const std::vector<Edge>& get_edge_list() const { return edges_; }
+
+  IdSpan<EdgeId> connected_edges_ids(VertexId vertex_id) const override;
+
+  void set_vertex_depth(VertexId vertex_id, GraphDepth depth) override;
+
+  bool is_connected(VertexId from_vertex_id,
+                    VertexId to_vertex_id) const override;
+
+  EdgeColor get_edge_color(VertexId from_vertex_id,
+                           VertexId to_vertex_id) const override {
+    return determine_edge_color(*this, from_vertex_id, to_vertex_id);
+  }
+
+  GraphDepth vertex_depth(VertexId vertex_id) const override {
+    return vertex_depths_.at(vertex_id);
+  }
+
+  IdSpan<VertexId> get_vertices_with_depth(GraphDepth depth) const override;
+
+  IdSpan<EdgeId> get_edge_ids_with_color(EdgeColor color) const override;
+
+  GraphDepth depth() const override { return depth_offsets_.size() - 1; }
+
+ private:
+  std::vector<Vertex> vertices_;
+  std::vector<Edge> edges_;
+  std::vector<GraphDepth> vertex_depths_;
+  // Edges of vertex v are
+  // adjacent_edge_ids_[edge_offsets_[v], edge_offsets_[v + 1]).
+  std::vector<size_t> edge_offsets_;
+  std::vector<EdgeId> adjacent_edge_ids_;
+  // Same layout, indexed by depth - kGraphBaseDepth.
+  std::vector<size_t> depth_offsets_;
+  std::vector<VertexId> depth_vertex_ids_;
+  // Same layout, indexed by color.
+  std::array<size_t, kEdgeColorsCount + 1> color_offsets_ = {};
+  std::vector<EdgeId> color_edge_ids_;
+};
+
+}  // namespace uni_course_cpp
@@ -0,0 +1,91 @@
+#include "flat_graph.hpp"
+#include <cassert>
+
+namespace uni_course_cpp {
+
+VertexId FlatGraph::add_vertex() {
+  const VertexId new_vertex_id = get_new_vertex_id();
+  vertices_.emplace_back(new_vertex_id);
+  adjacency_list_.emplace_back();
+
+  vertex_depths_.push_back(kGraphBaseDepth);
+  if (depth_to_vertices_.empty()) {
+    depth_to_vertices_.emplace_back();
+  }
+  vertex_depth_positions_.push_back(depth_to_vertices_.front().size());
+  depth_to_vertices_.front().push_back(new_vertex_id);
+  return new_vertex_id;
+}
+
+EdgeId FlatGraph::add_edge(VertexId from_vertex_id, VertexId to_vertex_id) {
+  assert(has_vertex(from_vertex_id));
+  assert(has_vertex(to_vertex_id));
+
+  const auto color = get_edge_color(from_vertex_id, to_vertex_id);
+  if (color == EdgeColor::Grey) {
+    set_vertex_depth(to_vertex_id, vertex_depth(from_vertex_id) + 1);
+  }
+  const EdgeId edge_id = get_new_edge_id();
+  edges_.emplace_back(edge_id, from_vertex_id, to_vertex_id, color);
+  if (from_vertex_id != to_vertex_id) {
+    adjacency_list_[from_vertex_id].push_back(edge_id);
+  }
+  adjacency_list_[to_vertex_id].push_back(edge_id);
+  color_to_edges_[static_cast<int>(color)].push_back(edge_id);
+  return edge_id;
+}
+
+IdSpan<EdgeId> FlatGraph::connected_edges_ids(VertexId vertex_id) const {
+  if (!has_vertex(vertex_id)) {
+    return {};
+  }
+  return IdSpan<EdgeId>(adjacency_list_[vertex_id]);
+}
+
+void FlatGraph::set_vertex_depth(VertexId vertex_id, GraphDepth depth) {
+  assert(depth >= kGraphBaseDepth);
+  const auto old_depth = vertex_depths_.at(vertex_id);
+  if (old_depth == depth) {
+    return;
+  }
+  const auto depth_index = depth - kGraphBaseDepth;
+  if (depth_index >= static_cast<GraphDepth>(depth_to_vertices_.size())) {
+    depth_to_vertices_.resize(depth_index + 1);
+  }
+
+  // The last vertex of the old bucket takes the place of the moved one.
+  auto& old_depth_vertices = depth_to_vertices_[old_depth - kGraphBaseDepth];
+  const auto position = vertex_depth_positions_[vertex_id];
+  const auto last_vertex_id = old_depth_vertices.back();
+  old_depth_vertices[position] = last_vertex_id;
+  vertex_depth_positions_[last_vertex_id] = position;
+  old_depth_vertices.pop_back();
+
+  auto& depth_vertices = depth_to_vertices_[depth_index];
+  vertex_depth_positions_[vertex_id] = depth_vertices.size();
+  depth_vertices.push_back(vertex_id);
+  vertex_depths_[vertex_id] = depth;
+}
+
+bool FlatGraph::is_connected(VertexId from_vertex_id,
+                             VertexId to_vertex_id) const {
+  for (const auto edge_id : adjacency_list_.at(from_vertex_id)) {
+    const auto& edge = edges_[edge_id];
+    if (edge.from_vertex_id() == to_vertex_id ||
+        edge.to_vertex_id() == to_vertex_id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+IdSpan<VertexId> FlatGraph::get_vertices_with_depth(GraphDepth depth) const {
+  const auto depth_index = depth - kGraphBaseDepth;
+  if (depth_index < 0 ||
+      depth_index >= static_cast<GraphDepth>(depth_to_vertices_.size())) {
+    return {};
+  }
+  return IdSpan<VertexId>(depth_to_vertices_[depth_index]);
+}
+
+}  // namespace uni_course_cpp
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "graph_elements.hpp"
+#include "interfaces/i_graph.hpp"
+
+namespace uni_course_cpp {
+
+// Flat vector backend. Ids are dense, so every index is a vector addressed
+// by id, depth or color instead of a hash map: lookups are plain offsets
+// and no memory goes to buckets or nodes.
+class FlatGraph final : public IGraph {
+ public:
+  VertexId add_vertex() override;
+
+  EdgeId add_edge(VertexId from_vertex_id, VertexId to_vertex_id) override;
+
+  bool has_vertex(VertexId vertex_id) const override {
+    return vertex_id < vertices_.size();
+  }
+
+  InterfaceSpan<IVertex> get_vertices() const override {
+    return InterfaceSpan<IVertex>(vertices_);
+  }
+
+  InterfaceSpan<IEdge> get_edges() const override {
+    return InterfaceSpan<IEdge>(edges_);
+  }
+
+  // Same elements as above, as their concrete types.
+  const std::vector<Vertex>& get_vertex_list() const { return vertices_; }
+  const std::vector<Edge>& get_edge_list() const { return edges_; }
+
+  IdSpan<EdgeId> connected_edges_ids(VertexId vertex_id) const override;
+
+  void set_vertex_depth(VertexId vertex_id, GraphDepth depth) override;
+
+  bool is_connected(VertexId from_vertex_id,
+                    VertexId to_vertex_id) const override;
+
+  EdgeColor get_edge_color(VertexId from_vertex_id,
+                           VertexId to_vertex_id) const override {
+    return determine_edge_color(*this, from_vertex_id, to_vertex_id);
+  }
+
+  GraphDepth vertex_depth(VertexId vertex_id) const override {
+    return vertex_depths_.at(vertex_id);
+  }
+
+  IdSpan<VertexId> get_vertices_with_depth(GraphDepth depth) const override;
+
+  IdSpan<EdgeId> get_edge_ids_with_color(EdgeColor color) const override {
+    return IdSpan<EdgeId>(color_to_edges_[static_cast<int>(color)]);
+  }
+
+  GraphDepth depth() const override { return depth_to_vertices_.size(); }
+
+ private:
+  VertexId get_new_vertex_id() const {
+    if (vertices_.size() == std::numeric_limits<VertexId>::max()) {
+      throw std::overflow_error("Vertex ids are exhausted");
+    }
+    return vertices_.size();
+  }
+  EdgeId get_new_edge_id() const {
+    if (edges_.size() == std::numeric_limits<EdgeId>::max()) {
+      throw std::overflow_error("Edge ids are exhausted");
+    }
+    return edges_.size();
+  }
+
+  std::vector<Vertex> vertices_;
+  std::vector<Edge> edges_;
+  std::vector<std::vector<EdgeId>> adjacency_list_;
+  std::vector<GraphDepth> vertex_depths_;
+  // Indexed by depth - kGraphBaseDepth.
+  std::vector<std::vector<VertexId>> depth_to_vertices_;
+  // Index of every vertex inside its depth bucket, so moving a vertex to
+  // another depth is a swap with the bucket's last element.
+  std::vector<size_t> vertex_depth_positions_;
+  std::array<std::vector<EdgeId>, kEdgeColorsCount> color_to_edges_;
+};
+
+}  // namespace uni_course_cpp
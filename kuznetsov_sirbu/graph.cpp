@@ -8,11 +8,11 @@ namespace uni_course_cpp {
 
 VertexId Graph::add_vertex() {
   const VertexId new_vertex_id = get_new_vertex_id();
-  vertices_.emplace_back(std::make_unique<Vertex>(new_vertex_id));
+  vertices_.emplace_back(new_vertex_id);
   adjacency_list_[new_vertex_id] = {};
 
-  vertex_depths_[new_vertex_id] = kBaseDepth;
-  depth_to_vertices_[kBaseDepth].emplace_back(new_vertex_id);
+  vertex_depths_[new_vertex_id] = kGraphBaseDepth;
+  depth_to_vertices_[kGraphBaseDepth].emplace_back(new_vertex_id);
   return new_vertex_id;
 }
 
@@ -25,9 +25,8 @@ EdgeId Graph::add_edge(VertexId from_vertex_id, VertexId to_vertex_id) {
     set_vertex_depth(to_vertex_id, vertex_depth(from_vertex_id) + 1);
   }
   const EdgeId edge_id = get_new_edge_id();
-  edges_.emplace_back(
-      std::make_unique<Edge>(edge_id, from_vertex_id, to_vertex_id, color));
-  if (from_vertex_id != edge_id) {
+  edges_.emplace_back(edge_id, from_vertex_id, to_vertex_id, color);
+  if (from_vertex_id != to_vertex_id) {
     adjacency_list_[from_vertex_id].emplace_back(edge_id);
   }
   adjacency_list_[to_vertex_id].emplace_back(edge_id);
@@ -35,21 +34,21 @@ EdgeId Graph::add_edge(VertexId from_vertex_id, VertexId to_vertex_id) {
   return edge_id;
 }
 
-const std::vector<EdgeId>& Graph::connected_edges_ids(
-    VertexId vertex_id) const {
-  if (!has_vertex(vertex_id)) {
-    static std::vector<EdgeId> empty_edges_list;
-    return empty_edges_list;
+IdSpan<EdgeId> Graph::connected_edges_ids(VertexId vertex_id) const {
+  const auto edge_ids = adjacency_list_.find(vertex_id);
+  if (edge_ids == adjacency_list_.end()) {
+    return {};
   }
-  return adjacency_list_.at(vertex_id);
+  return IdSpan<EdgeId>(edge_ids->second);
 }
 
 void Graph::set_vertex_depth(VertexId vertex_id, GraphDepth depth) {
   depth_to_vertices_[depth].emplace_back(vertex_id);
-  const auto pos = std::find(depth_to_vertices_[kBaseDepth].begin(),
-                             depth_to_vertices_[kBaseDepth].end(), vertex_id);
-  if (pos != depth_to_vertices_[kBaseDepth].end()) {
-    depth_to_vertices_[kBaseDepth].erase(pos);
+  auto& base_depth_vertices = depth_to_vertices_[kGraphBaseDepth];
+  const auto pos = std::find(base_depth_vertices.begin(),
+                             base_depth_vertices.end(), vertex_id);
+  if (pos != base_depth_vertices.end()) {
+    base_depth_vertices.erase(pos);
   }
   vertex_depths_[vertex_id] = depth;
 }
@@ -58,53 +57,28 @@ bool Graph::is_connected(VertexId from_vertex_id, VertexId to_vertex_id) const {
   const auto& edges_ids = adjacency_list_.at(from_vertex_id);
   for (const auto& edge_id : edges_ids) {
     const auto& edge = edges_[edge_id];
-    if (edge->from_vertex_id() == to_vertex_id ||
-        edge->to_vertex_id() == to_vertex_id) {
+    if (edge.from_vertex_id() == to_vertex_id ||
+        edge.to_vertex_id() == to_vertex_id) {
       return true;
     }
   }
   return false;
 }
 
-EdgeColor Graph::get_edge_color(VertexId from_vertex_id,
-                                VertexId to_vertex_id) const {
-  const auto from_vertex_depth = vertex_depths_.at(from_vertex_id);
-  const auto to_vertex_depth = vertex_depths_.at(to_vertex_id);
-
-  if (from_vertex_id == to_vertex_id) {
-    return EdgeColor::Green;
-  }
-  if (adjacency_list_.at(to_vertex_id).size() == 0) {
-    return EdgeColor::Grey;
-  }
-  if (to_vertex_depth - from_vertex_depth == kDifferenceYellowEdge &&
-      !is_connected(from_vertex_id, to_vertex_id)) {
-    return EdgeColor::Yellow;
-  }
-  if (to_vertex_depth - from_vertex_depth == kDifferenceRedEdge) {
-    return EdgeColor::Red;
-  }
-  throw std::runtime_error("Failed to determine color");
-}
-
-const std::vector<VertexId>& Graph::get_vertices_with_depth(
-    GraphDepth depth) const {
-  if (depth_to_vertices_.find(depth) != depth_to_vertices_.end()) {
-    return depth_to_vertices_.at(depth);
-  } else {
-    static std::vector<VertexId> tmp;
-    return tmp;
+IdSpan<VertexId> Graph::get_vertices_with_depth(GraphDepth depth) const {
+  const auto vertex_ids = depth_to_vertices_.find(depth);
+  if (vertex_ids == depth_to_vertices_.end()) {
+    return {};
   }
+  return IdSpan<VertexId>(vertex_ids->second);
 }
 
-const std::vector<EdgeId>& Graph::get_edge_ids_with_color(
-    EdgeColor color) const {
-  if (color_to_edges_.find(color) != color_to_edges_.end()) {
-    return color_to_edges_.at(color);
-  } else {
-    static std::vector<VertexId> tmp;
-    return tmp;
+IdSpan<EdgeId> Graph::get_edge_ids_with_color(EdgeColor color) const {
+  const auto edge_ids = color_to_edges_.find(color);
+  if (edge_ids == color_to_edges_.end()) {
+    return {};
   }
+  return IdSpan<EdgeId>(edge_ids->second);
 }
 
 }  // namespace uni_course_cpp
@@ -3,22 +3,25 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include "graph_elements.hpp"
 #include "interfaces/i_graph.hpp"
 
 namespace uni_course_cpp {
 
-class Graph : public IGraph {
+// Hash map backend. Stores vertices and edges by value in contiguous arrays
+// and keys the indices by id, depth and color. The class is final, so code
+// holding a Graph rather than an IGraph iterates get_vertex_list() and
+// get_edge_list() without virtual calls.
+class Graph final : public IGraph {
  public:
-  static constexpr GraphDepth kBaseDepth = 1;
-  static constexpr GraphDepth kDifferenceRedEdge = 2;
-  static constexpr GraphDepth kDifferenceYellowEdge = 1;
-
   VertexId add_vertex() override;
 
   EdgeId add_edge(VertexId from_vertex_id, VertexId to_vertex_id) override;
@@ -27,16 +30,19 @@ class Graph : public IGraph {
     return adjacency_list_.find(vertex_id) != adjacency_list_.end();
   }
 
-  const std::vector<std::unique_ptr<IVertex>>& get_vertices() const override {
-    return vertices_;
+  InterfaceSpan<IVertex> get_vertices() const override {
+    return InterfaceSpan<IVertex>(vertices_);
   }
 
-  const std::vector<std::unique_ptr<IEdge>>& get_edges() const override {
-    return edges_;
+  InterfaceSpan<IEdge> get_edges() const override {
+    return InterfaceSpan<IEdge>(edges_);
   }
 
-  const std::vector<EdgeId>& connected_edges_ids(
-      VertexId vertex_id) const override;
+  // Same elements as above, as their concrete types.
+  const std::vector<Vertex>& get_vertex_list() const { return vertices_; }
+  const std::vector<Edge>& get_edge_list() const { return edges_; }
+
+  IdSpan<EdgeId> connected_edges_ids(VertexId vertex_id) const override;
 
   void set_vertex_depth(VertexId vertex_id, GraphDepth depth) override;
 
@@ -44,59 +50,38 @@ class Graph : public IGraph {
                     VertexId to_vertex_id) const override;
 
   EdgeColor get_edge_color(VertexId from_vertex_id,
-                           VertexId to_vertex_id) const override;
+                           VertexId to_vertex_id) const override {
+    return determine_edge_color(*this, from_vertex_id, to_vertex_id);
+  }
 
   GraphDepth vertex_depth(VertexId vertex_id) const override {
     return vertex_depths_.at(vertex_id);
   }
 
-  const std::vector<VertexId>& get_vertices_with_depth(
-      GraphDepth depth) const override;
+  IdSpan<VertexId> get_vertices_with_depth(GraphDepth depth) const override;
 
-  const std::vector<EdgeId>& get_edge_ids_with_color(
-      EdgeColor color) const override;
+  IdSpan<EdgeId> get_edge_ids_with_color(EdgeColor color) const override;
 
   GraphDepth depth() const override { return depth_to_vertices_.size(); }
 
  private:
-  struct Vertex : public IVertex {
-   public:
-    explicit Vertex(VertexId id) : id_(id) {}
-    VertexId id() const override { return id_; }
-
-   private:
-    VertexId id_ = 0;
-  };
-
-  struct Edge : public IEdge {
-   public:
-    Edge(EdgeId id,
-         VertexId from_vertex_id,
-         VertexId to_vertex_id,
-         EdgeColor color)
-        : id_(id),
-          from_vertex_id_(from_vertex_id),
-          to_vertex_id_(to_vertex_id),
-          color_(color) {}
-    EdgeId id() const override { return id_; }
-    VertexId from_vertex_id() const override { return from_vertex_id_; }
-    VertexId to_vertex_id() const override { return to_vertex_id_; }
-    EdgeColor color() const override { return color_; }
-
-   private:
-    EdgeColor color_ = EdgeColor::Grey;
-    EdgeId id_ = 0;
-    VertexId from_vertex_id_ = 0;
-    VertexId to_vertex_id_ = 0;
-  };
-
-  VertexId get_new_vertex_id() { return vertex_id_counter_++; }
-  EdgeId get_new_edge_id() { return edge_id_counter_++; }
+  VertexId get_new_vertex_id() {
+    if (vertex_id_counter_ == std::numeric_limits<VertexId>::max()) {
+      throw std::overflow_error("Vertex ids are exhausted");
+    }
+    return vertex_id_counter_++;
+  }
+  EdgeId get_new_edge_id() {
+    if (edge_id_counter_ == std::numeric_limits<EdgeId>::max()) {
+      throw std::overflow_error("Edge ids are exhausted");
+    }
+    return edge_id_counter_++;
+  }
 
   VertexId vertex_id_counter_ = 0;
   EdgeId edge_id_counter_ = 0;
-  std::vector<std::unique_ptr<IVertex>> vertices_;
-  std::vector<std::unique_ptr<IEdge>> edges_;
+  std::vector<Vertex> vertices_;
+  std::vector<Edge> edges_;
   std::unordered_map<VertexId, std::vector<EdgeId>> adjacency_list_;
   std::unordered_map<VertexId, GraphDepth> vertex_depths_;
   std::unordered_map<GraphDepth, std::vector<VertexId>> depth_to_vertices_;
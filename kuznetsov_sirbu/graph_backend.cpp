@@ -0,0 +1,39 @@
+#include "graph_backend.hpp"
+#include <array>
+#include <stdexcept>
+
+namespace uni_course_cpp {
+
+namespace {
+
+constexpr std::array<GraphBackend, 3> kGraphBackends = {
+    GraphBackend::HashMap, GraphBackend::FlatVector, GraphBackend::Csr};
+
+}  // namespace
+
+GraphBackend parse_graph_backend(const std::string& name) {
+  for (const auto backend : kGraphBackends) {
+    if (printing::print_graph_backend(backend) == name) {
+      return backend;
+    }
+  }
+  throw std::invalid_argument("Unknown graph backend: " + name);
+}
+
+namespace printing {
+
+std::string print_graph_backend(GraphBackend backend) {
+  switch (backend) {
+    case GraphBackend::HashMap:
+      return "hash_map";
+    case GraphBackend::FlatVector:
+      return "flat_vector";
+    case GraphBackend::Csr:
+      return "csr";
+  }
+  throw std::runtime_error("Failed to determine graph backend");
+}
+
+}  // namespace printing
+
+}  // namespace uni_course_cpp
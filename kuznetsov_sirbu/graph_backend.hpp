@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+
+namespace uni_course_cpp {
+
+// Storage behind the IGraph a GraphGenerator returns. Csr graphs are
+// generated into a FlatGraph and frozen once complete.
+enum class GraphBackend { HashMap, FlatVector, Csr };
+
+// Parses the name printed by print_graph_backend(), throws
+// std::invalid_argument for any other string.
+GraphBackend parse_graph_backend(const std::string& name);
+
+namespace printing {
+std::string print_graph_backend(GraphBackend backend);
+}  // namespace printing
+
+}  // namespace uni_course_cpp
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdexcept>
+#include "interfaces/i_edge.hpp"
+#include "interfaces/i_graph.hpp"
+#include "interfaces/i_vertex.hpp"
+
+namespace uni_course_cpp {
+
+// Depth differences between the ends of yellow and red edges.
+inline constexpr GraphDepth kDifferenceYellowEdge = 1;
+inline constexpr GraphDepth kDifferenceRedEdge = 2;
+inline constexpr int kEdgeColorsCount = 4;
+
+// Value types shared by the graph backends. They are final, so code holding
+// a concrete backend calls their accessors without virtual dispatch.
+struct Vertex final : public IVertex {
+ public:
+  explicit Vertex(VertexId id) : id_(id) {}
+  VertexId id() const override { return id_; }
+
+ private:
+  VertexId id_ = 0;
+};
+
+struct Edge final : public IEdge {
+ public:
+  Edge(EdgeId id,
+       VertexId from_vertex_id,
+       VertexId to_vertex_id,
+       EdgeColor color)
+      : id_(id),
+        from_vertex_id_(from_vertex_id),
+        to_vertex_id_(to_vertex_id),
+        color_(color) {}
+  EdgeId id() const override { return id_; }
+  VertexId from_vertex_id() const override { return from_vertex_id_; }
+  VertexId to_vertex_id() const override { return to_vertex_id_; }
+  EdgeColor color() const override { return color_; }
+
+ private:
+  EdgeId id_ = 0;
+  VertexId from_vertex_id_ = 0;
+  VertexId to_vertex_id_ = 0;
+  EdgeColor color_ = EdgeColor::Grey;
+};
+
+// Color that an edge between the vertices gets, the same for every backend.
+template <typename GraphType>
+EdgeColor determine_edge_color(const GraphType& graph,
+                               VertexId from_vertex_id,
+                               VertexId to_vertex_id) {
+  const auto from_vertex_depth = graph.vertex_depth(from_vertex_id);
+  const auto to_vertex_depth = graph.vertex_depth(to_vertex_id);
+
+  if (from_vertex_id == to_vertex_id) {
+    return EdgeColor::Green;
+  }
+  if (graph.connected_edges_ids(to_vertex_id).size() == 0) {
+    return EdgeColor::Grey;
+  }
+  if (to_vertex_depth - from_vertex_depth == kDifferenceYellowEdge &&
+      !graph.is_connected(from_vertex_id, to_vertex_id)) {
+    return EdgeColor::Yellow;
+  }
+  if (to_vertex_depth - from_vertex_depth == kDifferenceRedEdge) {
+    return EdgeColor::Red;
+  }
+  throw std::runtime_error("Failed to determine color");
+}
+
+}  // namespace uni_course_cpp
@@ -9,6 +9,8 @@
 #include <random>
 #include <thread>
 #include <utility>
+#include "csr_graph.hpp"
+#include "flat_graph.hpp"
 
 namespace uni_course_cpp {
 
@@ -29,22 +31,25 @@ double probaility_generate_grey_edge(GraphDepth current_depth,
   if (graph_depth == 0) {
     return 1.0;
   } else {
-    return 1.0 - static_cast<double>((current_depth - Graph::kBaseDepth)) /
-                     (graph_depth - Graph::kBaseDepth);
+    return 1.0 - static_cast<double>((current_depth - kGraphBaseDepth)) /
+                     (graph_depth - kGraphBaseDepth);
   }
 }
 
-VertexId get_random_vertex_id(int size) {
+// Index into a list of the given non-zero size, which may exceed the int
+// range with 64 bit ids.
+size_t get_random_index(size_t size) {
   std::random_device rand_device;
-  std::mt19937 gen(rand_device());
-  std::uniform_int_distribution<> distrib(0, size - 1);
+  std::mt19937_64 gen(rand_device());
+  std::uniform_int_distribution<size_t> distrib(0, size - 1);
   return distrib(gen);
 }
 
+template <typename GraphType>
 std::vector<VertexId> get_unconnected_vertex_ids(
-    const Graph& graph,
+    const GraphType& graph,
     VertexId vertex_from_id,
-    const std::vector<VertexId>& vertex_ids,
+    IdSpan<VertexId> vertex_ids,
     std::mutex& graph_mutex) {
   std::vector<VertexId> not_connected_vertex_ids;
   for (const auto& vertex_to_id : vertex_ids) {
@@ -60,29 +65,29 @@ std::vector<VertexId> get_unconnected_vertex_ids(
   return not_connected_vertex_ids;
 }
 
-void add_red_edge(Graph& graph,
+template <typename GraphType>
+void add_red_edge(GraphType& graph,
                   VertexId vertex_from_id,
                   VertexId vertex_to_id,
                   std::mutex& graph_mutex) {
-  const GraphDepth vertex_from_depth = graph.vertex_depth(vertex_from_id);
   const std::lock_guard<std::mutex> graph_lock(graph_mutex);
   graph.add_edge(vertex_from_id, vertex_to_id);
 }
 
-void generate_red_edges(Graph& graph, std::mutex& graph_mutex) {
-  const auto& vertices = graph.get_vertices();
+template <typename GraphType>
+void generate_red_edges(GraphType& graph, std::mutex& graph_mutex) {
+  const auto& vertices = graph.get_vertex_list();
   std::for_each(
       vertices.begin(), vertices.end(),
-      [&graph, &graph_mutex](
-          const std::unique_ptr<uni_course_cpp::IVertex>& vertex_from) {
+      [&graph, &graph_mutex](const Vertex& vertex_from) {
         if (!check_probability(kProbabilityRed)) {
-          const auto vertex_from_id = vertex_from->id();
+          const auto vertex_from_id = vertex_from.id();
           const GraphDepth vertex_depth = graph.vertex_depth(vertex_from_id);
           const auto& vertex_ids = graph.get_vertices_with_depth(
-              vertex_depth + Graph::kDifferenceRedEdge);
+              vertex_depth + kDifferenceRedEdge);
           if (!vertex_ids.empty()) {
             const VertexId vertex_to_id =
-                vertex_ids.at(get_random_vertex_id(vertex_ids.size()));
+                vertex_ids.at(get_random_index(vertex_ids.size()));
 
             add_red_edge(graph, vertex_from_id, vertex_to_id, graph_mutex);
           }
@@ -90,7 +95,8 @@ void generate_red_edges(Graph& graph, std::mutex& graph_mutex) {
       });
 }
 
-void try_generate_green_edge(Graph& graph,
+template <typename GraphType>
+void try_generate_green_edge(GraphType& graph,
                              VertexId vertex_id,
                              std::mutex& graph_mutex) {
   if (check_probability(kProbabilityGreen)) {
@@ -99,43 +105,43 @@ void try_generate_green_edge(Graph& graph,
   }
 }
 
-void generate_green_edges(Graph& graph, std::mutex& graph_mutex) {
-  const auto& vertices = graph.get_vertices();
+template <typename GraphType>
+void generate_green_edges(GraphType& graph, std::mutex& graph_mutex) {
+  const auto& vertices = graph.get_vertex_list();
   std::for_each(vertices.begin(), vertices.end(),
-                [&graph, &graph_mutex](
-                    const std::unique_ptr<uni_course_cpp::IVertex>& vertex) {
-                  try_generate_green_edge(graph, vertex->id(), graph_mutex);
+                [&graph, &graph_mutex](const Vertex& vertex) {
+                  try_generate_green_edge(graph, vertex.id(), graph_mutex);
                 });
 }
-void add_yellow_edge(Graph& graph,
+template <typename GraphType>
+void add_yellow_edge(GraphType& graph,
                      VertexId vertex_from_id,
                      VertexId vertex_to_id,
                      std::mutex& graph_mutex) {
-  const GraphDepth vertex_from_depth = graph.vertex_depth(vertex_from_id);
   const std::lock_guard<std::mutex> graph_lock(graph_mutex);
   graph.add_edge(vertex_from_id, vertex_to_id);
 }
 
-void generate_yellow_edges(Graph& graph, std::mutex& graph_mutex) {
-  const auto& vertices = graph.get_vertices();
+template <typename GraphType>
+void generate_yellow_edges(GraphType& graph, std::mutex& graph_mutex) {
+  const auto& vertices = graph.get_vertex_list();
   std::for_each(
       vertices.begin(), vertices.end(),
-      [&graph, &graph_mutex](
-          const std::unique_ptr<uni_course_cpp::IVertex>& vertex_from) {
-        const auto vertex_from_id = vertex_from->id();
+      [&graph, &graph_mutex](const Vertex& vertex_from) {
+        const auto vertex_from_id = vertex_from.id();
         const GraphDepth vertex_depth = graph.vertex_depth(vertex_from_id);
         const double probability_generate =
-            static_cast<double>((vertex_depth - Graph::kBaseDepth)) /
-            (graph.depth() - Graph::kBaseDepth - Graph::kDifferenceYellowEdge);
+            static_cast<double>((vertex_depth - kGraphBaseDepth)) /
+            (graph.depth() - kGraphBaseDepth - kDifferenceYellowEdge);
 
         if (check_probability(probability_generate)) {
           const auto& vertex_ids = graph.get_vertices_with_depth(
-              vertex_depth + Graph::kDifferenceYellowEdge);
+              vertex_depth + kDifferenceYellowEdge);
           const auto not_connected_vertex_ids = get_unconnected_vertex_ids(
               graph, vertex_from_id, vertex_ids, graph_mutex);
           if (!not_connected_vertex_ids.empty()) {
             const VertexId vertex_to_id = not_connected_vertex_ids.at(
-                get_random_vertex_id(not_connected_vertex_ids.size()));
+                get_random_index(not_connected_vertex_ids.size()));
             add_yellow_edge(graph, vertex_from_id, vertex_to_id, graph_mutex);
           }
         }
@@ -145,7 +151,20 @@ void generate_yellow_edges(Graph& graph, std::mutex& graph_mutex) {
 }  // namespace
 
 std::unique_ptr<IGraph> GraphGenerator::generate() const {
-  auto graph = Graph();
+  switch (params_.backend()) {
+    case GraphBackend::HashMap:
+      return std::make_unique<Graph>(generate_graph<Graph>());
+    case GraphBackend::FlatVector:
+      return std::make_unique<FlatGraph>(generate_graph<FlatGraph>());
+    case GraphBackend::Csr:
+      return std::make_unique<CsrGraph>(generate_graph<FlatGraph>());
+  }
+  throw std::runtime_error("Failed to determine graph backend");
+}
+
+template <typename GraphType>
+GraphType GraphGenerator::generate_graph() const {
+  auto graph = GraphType();
   std::mutex graph_mutex;
 
   if (params_.depth() < 0) {
@@ -166,10 +185,11 @@ std::unique_ptr<IGraph> GraphGenerator::generate() const {
     generating_yellow_edges.join();
     generating_red_edges.join();
   }
-  return std::make_unique<Graph>(std::move(graph));
+  return graph;
 }
 
-VertexId GraphGenerator::add_grey_edge(Graph& graph,
+template <typename GraphType>
+VertexId GraphGenerator::add_grey_edge(GraphType& graph,
                                        GraphDepth current_depth,
                                        VertexId vertex_id,
                                        std::mutex& graph_mutex) const {
@@ -179,7 +199,8 @@ VertexId GraphGenerator::add_grey_edge(Graph& graph,
   return next_vertex_id;
 }
 
-void GraphGenerator::generate_grey_branch(Graph& graph,
+template <typename GraphType>
+void GraphGenerator::generate_grey_branch(GraphType& graph,
                                           std::mutex& graph_mutex,
                                           VertexId root_vertex_id,
                                           GraphDepth current_depth) const {
@@ -198,7 +219,8 @@ void GraphGenerator::generate_grey_branch(Graph& graph,
   }
 }
 
-void GraphGenerator::generate_grey_edges(Graph& graph,
+template <typename GraphType>
+void GraphGenerator::generate_grey_edges(GraphType& graph,
                                          std::mutex& graph_mutex,
                                          VertexId root_vertex_id) const {
   using JobCallback = std::function<void()>;
@@ -211,7 +233,7 @@ void GraphGenerator::generate_grey_edges(Graph& graph,
   for (int i = 0; i < new_vertices_count; ++i) {
     jobs.push_back([&graph, &graph_mutex, root_vertex_id, this]() {
       generate_grey_branch(graph, graph_mutex, root_vertex_id,
-                           Graph::kBaseDepth);
+                           kGraphBaseDepth);
     });
   }
 
@@ -5,6 +5,7 @@
 #include <optional>
 #include <thread>
 #include "graph.hpp"
+#include "graph_backend.hpp"
 
 namespace uni_course_cpp {
 
@@ -12,30 +13,43 @@ class GraphGenerator {
  public:
   struct Params {
    public:
-    Params(GraphDepth depth, int new_vertices_count)
-        : depth_(depth), new_vertices_count_(new_vertices_count) {}
+    Params(GraphDepth depth,
+           int new_vertices_count,
+           GraphBackend backend = GraphBackend::HashMap)
+        : depth_(depth),
+          new_vertices_count_(new_vertices_count),
+          backend_(backend) {}
 
     GraphDepth depth() const { return depth_; }
     int new_vertices_count() const { return new_vertices_count_; }
+    GraphBackend backend() const { return backend_; }
 
    private:
     GraphDepth depth_ = 0;
     int new_vertices_count_ = 0;
+    GraphBackend backend_ = GraphBackend::HashMap;
   };
 
   explicit GraphGenerator(Params&& params) : params_(std::move(params)) {}
 
+  // Returns a graph stored in params.backend().
   std::unique_ptr<IGraph> generate() const;
 
  private:
-  VertexId add_grey_edge(Graph& graph,
+  // Generates into one of the mutable backends, Graph or FlatGraph.
+  template <typename GraphType>
+  GraphType generate_graph() const;
+  template <typename GraphType>
+  VertexId add_grey_edge(GraphType& graph,
                          GraphDepth current_depth,
                          VertexId vertex_id,
                          std::mutex& graph_mutex) const;
-  void generate_grey_edges(Graph& graph,
+  template <typename GraphType>
+  void generate_grey_edges(GraphType& graph,
                            std::mutex& graph_mutex,
                            VertexId root_vertex_id) const;
-  void generate_grey_branch(Graph& graph,
+  template <typename GraphType>
+  void generate_grey_branch(GraphType& graph,
                             std::mutex& graph_mutex,
                             VertexId root_vertex_id,
                             GraphDepth current_depth) const;
@@ -5,10 +5,16 @@ namespace uni_course_cpp {
 namespace printing {
 namespace json {
 
-std::string print_vertex(const IVertex& vertex, const IGraph& graph) {
+namespace {
+
+// Shared by the IGraph and backend overloads: instantiated for a backend,
+// the element accessors are direct calls on final classes.
+template <typename VertexType, typename GraphType>
+std::string print_vertex_impl(const VertexType& vertex,
+                              const GraphType& graph) {
   std::string result_json_vertex = "{\"id\":";
   result_json_vertex += std::to_string(vertex.id()) + ",";
-  const std::vector<EdgeId>& edge_ids = graph.connected_edges_ids(vertex.id());
+  const auto edge_ids = graph.connected_edges_ids(vertex.id());
 
   result_json_vertex += "\"edge_ids\":[";
   for (const auto& id : edge_ids) {
@@ -23,21 +29,8 @@ std::string print_vertex(const IVertex& vertex, const IGraph& graph) {
   return result_json_vertex;
 }
 
-std::string print_edge_color(EdgeColor edge_color) {
-  switch (edge_color) {
-    case EdgeColor::Grey:
-      return "grey";
-    case EdgeColor::Red:
-      return "red";
-    case EdgeColor::Yellow:
-      return "yellow";
-    case EdgeColor::Green:
-      return "green";
-  }
-  throw std::runtime_error("Failed to determine color");
-}
-
-std::string print_edge(const IEdge& edge) {
+template <typename EdgeType>
+std::string print_edge_impl(const EdgeType& edge) {
   std::string result_json_edge =
       "{\"id\":" + std::to_string(edge.id()) + ",\"vertex_ids\":" + "[" +
       std::to_string(edge.from_vertex_id()) + "," +
@@ -47,26 +40,85 @@ std::string print_edge(const IEdge& edge) {
   return result_json_edge;
 }
 
-std::string print_graph(const IGraph& graph) {
+template <typename GraphType, typename Vertices, typename Edges>
+std::string print_graph_impl(const GraphType& graph,
+                             const Vertices& vertices,
+                             const Edges& edges) {
   std::string result = "";
   result += "{\"depth\":" + std::to_string(graph.depth()) + ",";
   result += "\"vertices\":[";
 
-  for (const auto& vertex : graph.get_vertices()) {
-    result += print_vertex(*vertex, graph) + ",";
+  for (const auto& vertex : vertices) {
+    result += print_vertex_impl(vertex, graph) + ",";
   }
   if (result.back() == ',')
     result.pop_back();
   result += "],\"edges\":[";
 
-  for (const auto& edge : graph.get_edges()) {
-    result += print_edge(*edge) + ",";
+  for (const auto& edge : edges) {
+    result += print_edge_impl(edge) + ",";
   }
   if (result.back() == ',')
     result.pop_back();
   result += "]}\n";
   return result;
 }
+
+}  // namespace
+
+std::string print_vertex(const IVertex& vertex, const IGraph& graph) {
+  return print_vertex_impl(vertex, graph);
+}
+
+std::string print_edge_color(EdgeColor edge_color) {
+  switch (edge_color) {
+    case EdgeColor::Grey:
+      return "grey";
+    case EdgeColor::Red:
+      return "red";
+    case EdgeColor::Yellow:
+      return "yellow";
+    case EdgeColor::Green:
+      return "green";
+  }
+  throw std::runtime_error("Failed to determine color");
+}
+
+std::string print_edge(const IEdge& edge) {
+  return print_edge_impl(edge);
+}
+
+std::string print_edge(const Edge& edge) {
+  return print_edge_impl(edge);
+}
+
+std::string print_graph(const IGraph& graph) {
+  if (const auto* hash_map_graph = dynamic_cast<const Graph*>(&graph)) {
+    return print_graph(*hash_map_graph);
+  }
+  if (const auto* flat_graph = dynamic_cast<const FlatGraph*>(&graph)) {
+    return print_graph(*flat_graph);
+  }
+  if (const auto* csr_graph = dynamic_cast<const CsrGraph*>(&graph)) {
+    return print_graph(*csr_graph);
+  }
+  return print_graph_impl(graph, graph.get_vertices(), graph.get_edges());
+}
+
+std::string print_graph(const Graph& graph) {
+  return print_graph_impl(graph, graph.get_vertex_list(),
+                          graph.get_edge_list());
+}
+
+std::string print_graph(const FlatGraph& graph) {
+  return print_graph_impl(graph, graph.get_vertex_list(),
+                          graph.get_edge_list());
+}
+
+std::string print_graph(const CsrGraph& graph) {
+  return print_graph_impl(graph, graph.get_vertex_list(),
+                          graph.get_edge_list());
+}
 }  // namespace json
 }  // namespace printing
 }  // namespace uni_course_cpp
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <string>
+#include "csr_graph.hpp"
+#include "flat_graph.hpp"
+#include "graph.hpp"
 #include "interfaces/i_graph.hpp"
 
 namespace uni_course_cpp {
@@ -10,7 +13,12 @@ namespace json {
 std::string print_vertex(const IVertex& vertex, const IGraph& graph);
 std::string print_edge_color(EdgeColor edge_color);
 std::string print_edge(const IEdge& edge);
+std::string print_edge(const Edge& edge);
+// Prints a backend through its overload below, without virtual calls.
 std::string print_graph(const IGraph& graph);
+std::string print_graph(const Graph& graph);
+std::string print_graph(const FlatGraph& graph);
+std::string print_graph(const CsrGraph& graph);
 
 }  // namespace json
 }  // namespace printing
@@ -3,7 +3,11 @@
 #include "i_vertex.hpp"
 
 namespace uni_course_cpp {
-using EdgeId = int;
+#ifdef UNI_COURSE_CPP_64_BIT_IDS
+using EdgeId = uint64_t;
+#else
+using EdgeId = uint32_t;
+#endif
 enum class EdgeColor { Grey, Green, Yellow, Red };
 struct IEdge {
  public:
@@ -1,8 +1,15 @@
 #pragma once
 
+#include <cstdint>
+
 namespace uni_course_cpp {
 
-using VertexId = int;
+// Ids are 32 bit unless the build defines UNI_COURSE_CPP_64_BIT_IDS.
+#ifdef UNI_COURSE_CPP_64_BIT_IDS
+using VertexId = uint64_t;
+#else
+using VertexId = uint32_t;
+#endif
 
 struct IVertex {
  public:
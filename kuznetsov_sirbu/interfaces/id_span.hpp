@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace uni_course_cpp {
+
+// Read-only view of contiguous ids, so that a backend answers id list
+// queries from a vector of its own or from a slice of one shared array.
+template <typename Id>
+class IdSpan {
+ public:
+  IdSpan() = default;
+  // Explicit, since the span does not own the ids: it has to be spelled
+  // out wherever the vector is known to outlive it.
+  explicit IdSpan(const std::vector<Id>& ids)
+      : data_(ids.data()), size_(ids.size()) {}
+  // A temporary vector would be gone before the span is read.
+  IdSpan(std::vector<Id>&&) = delete;
+  IdSpan(const Id* data, size_t size) : data_(data), size_(size) {}
+
+  const Id* begin() const { return data_; }
+  const Id* end() const { return data_ + size_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const Id& operator[](size_t index) const { return data_[index]; }
+  const Id& at(size_t index) const {
+    if (index >= size_) {
+      throw std::out_of_range("Id span index is out of range");
+    }
+    return data_[index];
+  }
+
+ private:
+  const Id* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace uni_course_cpp
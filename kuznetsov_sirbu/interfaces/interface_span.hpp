@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace uni_course_cpp {
+
+// Read-only view of contiguous objects of one concrete type implementing
+// Interface. Lets an interface hand out value-stored elements without
+// exposing their type or keeping each of them in a separate allocation.
+template <typename Interface>
+class InterfaceSpan {
+  using GetObject = const Interface& (*)(const void* data, size_t index);
+
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Interface;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Interface*;
+    using reference = const Interface&;
+
+    Iterator(const void* data, GetObject get_object, size_t index)
+        : data_(data), get_object_(get_object), index_(index) {}
+
+    reference operator*() const { return get_object_(data_, index_); }
+    pointer operator->() const { return &get_object_(data_, index_); }
+
+    Iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    Iterator operator++(int) {
+      auto previous = *this;
+      ++index_;
+      return previous;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+   private:
+    const void* data_ = nullptr;
+    GetObject get_object_ = nullptr;
+    size_t index_ = 0;
+  };
+
+  template <typename Object>
+  explicit InterfaceSpan(const std::vector<Object>& objects)
+      : data_(objects.data()),
+        size_(objects.size()),
+        get_object_(&get_object<Object>) {}
+
+  const Interface& operator[](size_t index) const {
+    return get_object_(data_, index);
+  }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  Iterator begin() const { return Iterator(data_, get_object_, 0); }
+  Iterator end() const { return Iterator(data_, get_object_, size_); }
+
+ private:
+  template <typename Object>
+  static const Interface& get_object(const void* data, size_t index) {
+    return static_cast<const Object*>(data)[index];
+  }
+
+  const void* data_ = nullptr;
+  size_t size_ = 0;
+  GetObject get_object_ = nullptr;
+};
+
+}  // namespace uni_course_cpp
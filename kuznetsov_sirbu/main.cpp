@@ -7,6 +7,7 @@
 
 #include "config.hpp"
 #include "graph.hpp"
+#include "graph_backend.hpp"
 #include "graph_generation_controller.hpp"
 #include "graph_generator.hpp"
 #include "graph_json_printing.hpp"
@@ -122,14 +123,17 @@ std::vector<std::unique_ptr<uni_course_cpp::IGraph>> generate_graphs(
 
 }  // namespace
 
-int main() {
+int main(int argc, char** argv) {
+  const auto backend = (argc > 1)
+                           ? uni_course_cpp::parse_graph_backend(argv[1])
+                           : uni_course_cpp::config::kDefaultGraphBackend;
   const int depth = handle_depth_input();
   const int new_vertices_count = handle_new_vertices_count_input();
   const int graphs_count = handle_graphs_count_input();
   const int threads_count = handle_threads_count_input();
   prepare_temp_directory();
-  auto params =
-      uni_course_cpp::GraphGenerator::Params(depth, new_vertices_count);
+  auto params = uni_course_cpp::GraphGenerator::Params(
+      depth, new_vertices_count, backend);
 
   const auto graphs =
       generate_graphs(std::move(params), graphs_count, threads_count);
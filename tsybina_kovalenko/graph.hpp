@@ -75,11 +75,15 @@ class Graph {
     return result;
   }
 
+  // Scans the edges in place rather than through connected_vertices(), so
+  // the check does not allocate.
   bool is_connected(VertexId from_vertex_id, VertexId to_vertex_id) const {
-    const std::vector<VertexId>& from_vertex_ids =
-        connected_vertices(from_vertex_id);
-    return std::find(from_vertex_ids.begin(), from_vertex_ids.end(),
-                     to_vertex_id) != from_vertex_ids.end();
+    const auto& edge_ids = connections_.at(from_vertex_id);
+    return std::any_of(edge_ids.begin(), edge_ids.end(),
+                       [this, from_vertex_id, to_vertex_id](EdgeId edge_id) {
+                         return other_end_of(edge_id, from_vertex_id) ==
+                                to_vertex_id;
+                       });
   }
 
   struct Vertex {
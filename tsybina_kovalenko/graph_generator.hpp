@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <optional>
 #include <queue>
 #include <random>
 
@@ -88,17 +90,33 @@ class GraphGenerator {
     return probable_vertices.at(distribution(generator_));
   }
 
-  std::vector<Graph::VertexId> get_unconnected_vertex_ids(
+  // Picks uniformly among the vertices of the depth that are not connected
+  // to the given one without collecting them: one pass counts them, a
+  // single draw picks an index and a second pass walks to it.
+  std::optional<Graph::VertexId> select_random_unconnected_vertex(
       const Graph& graph,
       Graph::Depth depth,
       Graph::VertexId from_vertex_id) const {
-    std::vector<Graph::VertexId> unconnected_vertices;
-    for (auto vertex_id : graph.vertices_at_depth(depth)) {
-      if (!graph.is_connected(from_vertex_id, vertex_id)) {
-        unconnected_vertices.push_back(vertex_id);
+    const auto& depth_vertex_ids = graph.vertices_at_depth(depth);
+    const auto is_unconnected = [&graph, from_vertex_id](
+                                    Graph::VertexId vertex_id) {
+      return !graph.is_connected(from_vertex_id, vertex_id);
+    };
+    const int unconnected_vertices_count = std::count_if(
+        depth_vertex_ids.begin(), depth_vertex_ids.end(), is_unconnected);
+    if (unconnected_vertices_count == 0) {
+      return std::nullopt;
+    }
+
+    std::uniform_int_distribution<> distribution(
+        0, unconnected_vertices_count - 1);
+    int index = distribution(generator_);
+    for (auto vertex_id : depth_vertex_ids) {
+      if (is_unconnected(vertex_id) && index-- == 0) {
+        return vertex_id;
       }
     }
-    return unconnected_vertices;
+    return std::nullopt;
   }
 
   void generate_yellow_edges(Graph& graph) const {
@@ -110,11 +128,10 @@ class GraphGenerator {
       Graph::Depth required_depth = vertex_depth + Graph::kYellowEdgeDepthJump;
       for (Graph::VertexId vertex_id : graph.vertices_at_depth(vertex_depth)) {
         if (check_probability(success_chance)) {
-          std::vector<Graph::VertexId> unconnected_vertices =
-              get_unconnected_vertex_ids(graph, required_depth, vertex_id);
-          if (unconnected_vertices.size() > 0) {
-            graph.add_edge(vertex_id,
-                           select_random_vertex(unconnected_vertices));
+          const auto to_vertex_id = select_random_unconnected_vertex(
+              graph, required_depth, vertex_id);
+          if (to_vertex_id.has_value()) {
+            graph.add_edge(vertex_id, *to_vertex_id);
           }
         }
       }